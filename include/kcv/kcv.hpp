@@ -34,22 +34,39 @@
 
 #include <cerrno>       // errno
 #include <cmath>        // isinf, isnan
-#include <cstddef>      // size_t
-#include <cstdint>      // uint32_t
+#include <cstddef>      // ptrdiff_t, size_t
+#include <cstdint>      // uint32_t, uint64_t
 #include <cstdlib>      // strtod
-#include <algorithm>    // adjacent_find, clamp, lower_bound, max, min, sort
+#include <cstring>      // memchr, memcmp, memcpy
+#include <algorithm>    // adjacent_find, clamp, fill, lower_bound, make_heap, max, min, pop_heap, push_heap, rotate, sort
 #include <array>        // array
 #include <charconv>     // from_chars, to_chars
 #include <functional>   // less
+#include <iterator>     // distance, input_iterator_tag, next
 #include <locale>       // locale
 #include <limits>       // numeric_limits
 #include <map>          // map
+#include <memory>       // make_unique, unique_ptr
 #include <sstream>      // fixed, ostringstream
 #include <string>       // string
 #include <string_view>  // string_view
-#include <system_error> // errc
-#include <type_traits>  // enable_if, is_floating_point, is_integral, is_unsigned
-#include <utility>      // move
+#include <system_error> // errc, system_error
+#include <tuple>        // get, tuple
+#include <type_traits>  // enable_if, is_const, is_constant_evaluated, is_floating_point, is_integral, is_same, is_unsigned
+#include <utility>      // index_sequence, move, pair
+#include <vector>       // vector
+
+#ifdef KCV_ENABLE_STATS
+#include <chrono>       // duration_cast, nanoseconds, steady_clock
+#endif
+
+#ifdef KCV_ENABLE_LOADER
+#include <atomic>       // atomic
+#include <exception>    // current_exception, exception_ptr
+#include <fstream>      // ifstream
+#include <ios>          // streamsize
+#include <thread>       // thread
+#endif
 
 
 namespace kcv    {
@@ -68,29 +85,112 @@ using IsFloat = typename std::enable_if_t<
 // Character tests
 // ---------------
 
-inline bool isWs(char c)
+// Character classes, combined as bit flags in a table
+// indexed by the byte value, so that a test is one load.
+constexpr std::uint8_t wsClass{0x01};
+constexpr std::uint8_t digitClass{0x02};
+constexpr std::uint8_t alphaClass{0x04};
+constexpr std::uint8_t hexdigClass{0x08};
+constexpr std::uint8_t keyCharClass{0x10};
+constexpr std::uint8_t plainClass{0x20}; // ASCII without quote and backslash
+
+constexpr std::array<std::uint8_t, 256> makeCharClasses()
+{
+	std::array<std::uint8_t, 256> classes{};
+
+	for (int c{0}; c <= 0x7F; ++c)
+		if (c != '"' && c != '\\')
+			classes[c] |= plainClass;
+
+	for (const char c : {' ', '\n', '\r', '\t'})
+		classes[static_cast<unsigned char>(c)] |= wsClass;
+
+	for (int c{'0'}; c <= '9'; ++c)
+		classes[c] |= digitClass | hexdigClass | keyCharClass;
+
+	for (int c{'a'}; c <= 'z'; ++c)
+	{
+		classes[c] |= alphaClass | keyCharClass;
+		classes[c - 'a' + 'A'] |= alphaClass | keyCharClass;
+	}
+
+	for (int c{'a'}; c <= 'f'; ++c)
+	{
+		classes[c] |= hexdigClass;
+		classes[c - 'a' + 'A'] |= hexdigClass;
+	}
+
+	for (const char c : {'-', '.', '_'})
+		classes[static_cast<unsigned char>(c)] |= keyCharClass;
+
+	return classes;
+}
+
+inline constexpr std::array<std::uint8_t, 256> charClasses{makeCharClasses()};
+
+constexpr bool isClass(char c, std::uint8_t mask)
+{
+	return (charClasses[static_cast<unsigned char>(c)] & mask) != 0;
+}
+
+constexpr bool isWs(char c)
+{
+	return isClass(c, wsClass);
+}
+
+constexpr bool isDigit(char c)
 {
-	return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+	return isClass(c, digitClass);
 }
 
-inline bool isDigit(char c)
+constexpr bool isAlpha(char c)
 {
-	return ('0' <= c && c <= '9');
+	return isClass(c, alphaClass);
 }
 
-inline bool isAlpha(char c)
+constexpr bool isHexdig(char c)
 {
-	return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+	return isClass(c, hexdigClass);
 }
 
-inline bool isHexdig(char c)
+constexpr bool isKeyChar(char c)
 {
-	return isDigit(c) || ('A' <= c && c <= 'F') || ('a' <= c && c <= 'f');
+	return isClass(c, keyCharClass);
 }
 
-inline bool isKeyChar(char c)
+// Checks if the function is evaluated at compile time. Without
+// compiler support, it is assumed that it is not, in which case
+// DocumentView cannot be parsed at compile time.
+// KCV_HAS_IS_CONSTANT_EVALUATED tells if the support exists.
+#if defined(__cpp_lib_is_constant_evaluated)
+#define KCV_HAS_IS_CONSTANT_EVALUATED
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define KCV_HAS_IS_CONSTANT_EVALUATED
+#endif
+#endif
+
+constexpr bool isConstantEvaluated()
 {
-	return isAlpha(c) || isDigit(c) || c == '-' || c == '.' || c == '_';
+#if defined(__cpp_lib_is_constant_evaluated)
+	return std::is_constant_evaluated();
+#elif defined(KCV_HAS_IS_CONSTANT_EVALUATED)
+	return __builtin_is_constant_evaluated();
+#else
+	return false;
+#endif
+}
+
+constexpr bool isKey(std::string_view key)
+{
+	if (key.empty() || !isAlpha(key[0]))
+		return false;
+
+	for (std::size_t i{1}; i < key.size(); ++i)
+		if (!isKeyChar(key[i]))
+			return false;
+
+	return true;
 }
 
 
@@ -160,6 +260,132 @@ inline Whitespace tab(int count = 1)
 }
 
 
+// Value targets
+// -------------
+
+// Receives a string value in a caller-provided buffer.
+// The content is not null-terminated. If the capacity
+// is too small, the read fails and the required size
+// is stored instead.
+struct StringBuffer
+{
+	char* data;
+	std::size_t capacity;
+	std::size_t size{0};
+};
+
+
+// Parse limits
+// ------------
+
+// Bounds the resources that parsing may consume, so that
+// hostile input is rejected early. Zero means unlimited.
+// The size of an item spans from its key to its last value.
+// A token is never scanned beyond the item size limit.
+// The memory limit only applies to Document, and is compared
+// to an estimate: each item counts its key and value bytes,
+// and its map node as the size of the stored pair plus four
+// pointers for the tree links and allocator overhead.
+struct ParseLimits
+{
+	std::size_t maxDataSize{0};   // Bytes of the data string
+	std::size_t maxItemCount{0};  // Items of the document
+	std::size_t maxItemSize{0};   // Bytes of an item
+	std::size_t maxKeySize{0};    // Bytes of a key
+	std::size_t maxValueCount{0}; // Values of an item
+	std::size_t maxMemory{0};     // Bytes allocated by a Document, estimated
+};
+
+
+// Statistics
+// ----------
+
+// Counters of the current thread, which are only
+// collected if KCV_ENABLE_STATS is defined.
+struct Stats
+{
+	std::array<std::uint64_t, 11> tokens{}; // Indexed by TokenType
+	std::uint64_t bytes{0};                 // Scanned by the tokenizer
+	std::uint64_t conversions{0};           // Values read into a target
+	std::uint64_t lookups{0};               // Item lookups by key
+	std::uint64_t misses{0};                // Lookups of absent keys
+	std::uint64_t allocations{0};           // Map nodes and string buffers
+	std::uint64_t insertNanoseconds{0};     // Inserting Document items
+	std::uint64_t sortNanoseconds{0};       // Sorting DocumentView items
+};
+
+// The tokenizer can only be evaluated at compile time
+// if the statistics are disabled.
+#ifdef KCV_ENABLE_STATS
+	#define KCV_STATS(...) __VA_ARGS__
+	#define KCV_CONSTEXPR
+#else
+	#define KCV_STATS(...)
+	#define KCV_CONSTEXPR constexpr
+#endif
+
+inline Stats& threadStats()
+{
+	static thread_local Stats stats{};
+	return stats;
+}
+
+// Retrieves a snapshot of the counters of the current thread.
+inline Stats stats()
+{
+	return threadStats();
+}
+
+// Resets the counters of the current thread.
+inline void resetStats()
+{
+	threadStats() = Stats{};
+}
+
+inline void countInsertion(const std::string& key, const std::string& values)
+{
+	// The node, and each string that exceeds the small buffer
+	const std::size_t small{std::string{}.capacity()};
+	threadStats().allocations += 1
+		+ (key.capacity() > small ? 1 : 0)
+		+ (values.capacity() > small ? 1 : 0);
+}
+
+inline void countLookup(bool isFound)
+{
+	++threadStats().lookups;
+	if (!isFound)
+		++threadStats().misses;
+}
+
+#ifdef KCV_ENABLE_STATS
+class StatsTimer
+{
+	public:
+
+		explicit StatsTimer(std::uint64_t& target) :
+			target_{target},
+			start_{std::chrono::steady_clock::now()}
+		{}
+
+		StatsTimer(const StatsTimer&) = delete;
+		StatsTimer& operator=(const StatsTimer&) = delete;
+
+		~StatsTimer()
+		{
+			const auto duration{std::chrono::steady_clock::now() - start_};
+			target_ += static_cast<std::uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+		}
+
+	private:
+
+		std::uint64_t& target_;
+		std::chrono::steady_clock::time_point start_;
+};
+#endif
+
+
 // Private types
 // -------------
 
@@ -172,47 +398,58 @@ class Stream
 
 		Stream() = default;
 
-		Stream(const char* data, std::size_t count, std::size_t pos = 0) :
+		constexpr Stream(const char* data, std::size_t count, std::size_t pos = 0) :
 			data_{data},
 			end_{count},
 			pos_{std::min(pos, count)}
 		{}
 
-		explicit Stream(std::string_view view) :
+		constexpr explicit Stream(std::string_view view) :
 			Stream{view.data(), view.size()}
 		{}
 
-		const char* data() const
+		constexpr const char* data() const
 		{
 			return data_;
 		}
 
-		std::size_t pos() const
+		constexpr std::size_t pos() const
 		{
 			return pos_;
 		}
 
-		bool eof() const
+		constexpr bool eof() const
 		{
 			return pos_ >= end_;
 		}
 
-		char peek() const
+		constexpr std::size_t end() const
+		{
+			return end_;
+		}
+
+		// Moves the end, which must not precede the position.
+		constexpr void setEnd(std::size_t end)
+		{
+			end_ = end;
+		}
+
+		constexpr char peek() const
 		{
 			return pos_ < end_ ? data_[pos_] : 0;
 		}
 
-		char peek(std::size_t offset) const
+		constexpr char peek(std::size_t offset) const
 		{
 			return (end_ - pos_ > offset) ? data_[pos_ + offset] : 0;
 		}
 
-		void skip(std::size_t count = 1)
+		constexpr void skip(std::size_t count = 1)
 		{
 			pos_ += std::min(end_ - pos_, count);
 		}
 
-		bool accept(char c)
+		constexpr bool accept(char c)
 		{
 			if (peek() != c)
 				return false;
@@ -220,27 +457,30 @@ class Stream
 			return true;
 		}
 
-		bool acceptDigits()
+		// Skips all following characters of the given classes.
+		constexpr void skipClass(std::uint8_t mask)
+		{
+			while (pos_ < end_ && isClass(data_[pos_], mask))
+				++pos_;
+		}
+
+		constexpr bool acceptDigits()
 		{
 			if (!isDigit(peek()))
 				return false;
-			skip();
-			while (isDigit(peek()))
-				skip();
+			skipClass(digitClass);
 			return true;
 		}
 
-		bool acceptHexdigs()
+		constexpr bool acceptHexdigs()
 		{
 			if (!isHexdig(peek()))
 				return false;
-			skip();
-			while (isHexdig(peek()))
-				skip();
+			skipClass(hexdigClass);
 			return true;
 		}
 
-		bool acceptHexdigs(std::size_t count)
+		constexpr bool acceptHexdigs(std::size_t count)
 		{
 			while (count-- > 0)
 			{
@@ -251,7 +491,7 @@ class Stream
 			return true;
 		}
 
-		bool acceptScalar()
+		constexpr bool acceptScalar()
 		{
 			// https://www.unicode.org/versions/Unicode12.1.0/
 			// Table 3-7. Well-Formed UTF-8 Byte Sequences
@@ -303,7 +543,7 @@ class Stream
 			return true;
 		}
 
-		bool acceptEscape()
+		constexpr bool acceptEscape()
 		{
 			switch (peek())
 			{
@@ -345,34 +585,44 @@ class Token
 			strEscaped
 		};
 
-		Token(const char* data, std::size_t pos, std::size_t size, Type type) :
+		constexpr Token(const char* data, std::size_t pos, std::size_t size, Type type) :
 			data_{data},
 			pos_{pos},
 			size_{size},
 			type_{type}
 		{}
 
-		std::size_t pos() const
+		constexpr std::size_t pos() const
 		{
 			return pos_;
 		}
 
-		std::size_t size() const
+		constexpr std::size_t size() const
 		{
 			return size_;
 		}
 
-		bool isEof() const
+		constexpr Type type() const
+		{
+			return type_;
+		}
+
+		constexpr std::string_view text() const
+		{
+			return {data_ + pos_, size_};
+		}
+
+		constexpr bool isEof() const
 		{
 			return type_ == Type::eof;
 		}
 
-		bool isKey() const
+		constexpr bool isKey() const
 		{
 			return type_ == Type::key;
 		}
 
-		bool isValue() const
+		constexpr bool isValue() const
 		{
 			return type_ != Type::key
 				&& type_ != Type::eof
@@ -381,6 +631,8 @@ class Token
 
 		bool read(bool& target) const
 		{
+			KCV_STATS(++threadStats().conversions;)
+
 			switch (type_)
 			{
 				case Type::boolNo: target = false; return true;
@@ -392,6 +644,8 @@ class Token
 		template<typename T, IsInt<T> = true>
 		bool read(T& target) const
 		{
+			KCV_STATS(++threadStats().conversions;)
+
 			switch (type_)
 			{
 				case Type::numIntNeg:
@@ -407,6 +661,8 @@ class Token
 		template<typename T, IsFloat<T> = true>
 		bool read(T& target) const
 		{
+			KCV_STATS(++threadStats().conversions;)
+
 			switch (type_)
 			{
 				case Type::numIntPos:
@@ -418,6 +674,8 @@ class Token
 
 		bool read(std::string& target) const
 		{
+			KCV_STATS(++threadStats().conversions;)
+
 			switch (type_)
 			{
 				case Type::strLiteral: return rawLiteralString(target);
@@ -428,9 +686,23 @@ class Token
 
 		bool read(std::string_view& target) const
 		{
+			KCV_STATS(++threadStats().conversions;)
+
+			switch (type_)
+			{
+				case Type::strLiteral: return rawLiteralString(target);
+				default: return false;
+			}
+		}
+
+		bool read(StringBuffer& target) const
+		{
+			KCV_STATS(++threadStats().conversions;)
+
 			switch (type_)
 			{
 				case Type::strLiteral: return rawLiteralString(target);
+				case Type::strEscaped: return rawEscapedString(target);
 				default: return false;
 			}
 		}
@@ -476,111 +748,231 @@ class Token
 			return true;
 		}
 
-		template<typename T>
-		bool rawLiteralString(T& target) const
+		bool rawLiteralString(std::string& target) const
+		{
+			target.assign(data_ + pos_ + 1, size_ - 2);
+			return true;
+		}
+
+		bool rawLiteralString(std::string_view& target) const
+		{
+			target = std::string_view{data_ + pos_ + 1, size_ - 2};
+			return true;
+		}
+
+		bool rawLiteralString(StringBuffer& target) const
 		{
-			target = T{data_ + pos_ + 1, size_ - 2};
+			const std::size_t size{size_ - 2};
+			if (!fits(target, size))
+				return false;
+
+			// The data of an empty buffer may be null
+			if (size > 0)
+				std::memcpy(target.data, data_ + pos_ + 1, size);
 			return true;
 		}
 
 		bool rawEscapedString(std::string& target) const
 		{
-			enum class State{ copy, esc, hex };
-			State state{State::copy};
+			// Reuses the capacity of the target.
+			std::size_t size{0};
+			if (!rawEscapedSize(size))
+				return false;
 
-			int hexDigs{0};
-			char32_t hexVal{0};
+			target.resize(size);
+			rawEscapedCopy(target.data());
+			return true;
+		}
 
-			std::string out{};
-			out.reserve(size_ - 2);
+		bool rawEscapedString(StringBuffer& target) const
+		{
+			std::size_t size{0};
+			if (!rawEscapedSize(size) || !fits(target, size))
+				return false;
 
-			for (std::size_t i{1}; i < size_ - 1; ++i)
-			{
-				const char c{data_[pos_ + i]};
-				switch (state)
-				{
-					case State::copy:
-						if (c == '\\')
-							state = State::esc;
-						else
-							out.push_back(c);
-						break;
+			if (size > 0)
+				rawEscapedCopy(target.data);
+			return true;
+		}
 
-					case State::esc:
-						switch (c)
-						{
-							case '\\': out.push_back('\\'); state = State::copy; break;
-							case '"':  out.push_back('"');  state = State::copy; break;
-							case 'n':  out.push_back('\n'); state = State::copy; break;
-							case 'r':  out.push_back('\r'); state = State::copy; break;
-							case 't':  out.push_back('\t'); state = State::copy; break;
-							case 'u':  hexDigs = 4; state = State::hex; break;
-							case 'U':  hexDigs = 8; state = State::hex; break;
-							default: return false;
-						}
-						break;
+		static bool fits(StringBuffer& target, std::size_t size)
+		{
+			target.size = size;
+			return size <= target.capacity;
+		}
 
-					case State::hex:
-						hexVal *= 16;
-						if      ('0' <= c && c <= '9') hexVal += c - '0';
-						else if ('A' <= c && c <= 'F') hexVal += c - 'A' + 10;
-						else if ('a' <= c && c <= 'f') hexVal += c - 'a' + 10;
-						else return false;
+		bool rawEscapedSize(std::size_t& size) const
+		{
+			// Validates the escape sequences
+			// and computes the decoded size.
 
-						if (--hexDigs < 1)
-						{
-							if (!pushUtf8(out, hexVal))
-								return false;
+			const char* begin{data_ + pos_ + 1};
+			const char* const end{data_ + pos_ + size_ - 1};
+			std::size_t count{0};
 
-							hexVal = 0;
-							state = State::copy;
-						}
-						break;
-				}
-			}
+			while (const char* esc{findEscape(begin, end)})
+			{
+				count += static_cast<std::size_t>(esc - begin);
 
-			if (state != State::copy)
-				return false;
+				char32_t c{0};
+				if (!rawEscape(esc, end, c, begin))
+					return false;
+
+				const std::size_t unitCount{utf8Size(c)};
+				if (unitCount == 0)
+					return false;
+
+				count += unitCount;
+			}
 
-			target = std::move(out);
+			size = count + static_cast<std::size_t>(end - begin);
 			return true;
 		}
 
-		bool pushUtf8(std::string& s, char32_t c) const
+		void rawEscapedCopy(char* out) const
 		{
-			if (c <= 0x7F)
-			{
-				s.push_back(static_cast<char>(c));
-			}
-			else if (c <= 0x7FF)
+			// Expects validated escape sequences.
+			// Unescaped runs are copied in bulk.
+
+			const char* begin{data_ + pos_ + 1};
+			const char* const end{data_ + pos_ + size_ - 1};
+
+			while (const char* esc{findEscape(begin, end)})
 			{
-				s.push_back(static_cast<char>(0xC0 | (c >> 6 & 0x1F)));
-				s.push_back(static_cast<char>(0x80 | (c      & 0x3F)));
+				std::memcpy(out, begin, static_cast<std::size_t>(esc - begin));
+				out += esc - begin;
+
+				char32_t c{0};
+				rawEscape(esc, end, c, begin);
+				out = writeUtf8(out, c);
 			}
-			else if (0xD800 <= c && c <= 0xDFFF)
-			{
+
+			std::memcpy(out, begin, static_cast<std::size_t>(end - begin));
+		}
+
+		static const char* findEscape(const char* begin, const char* end)
+		{
+			return static_cast<const char*>(
+				std::memchr(begin, '\\', static_cast<std::size_t>(end - begin)));
+		}
+
+		static bool rawEscape(const char* esc, const char* end, char32_t& c, const char*& next)
+		{
+			// Decodes the escape sequence at esc, which starts
+			// with a backslash, and stores the position after it.
+
+			if (end - esc < 2)
 				return false;
-			}
-			else if (c <= 0xFFFF)
+
+			int hexDigs{0};
+			switch (esc[1])
 			{
-				s.push_back(static_cast<char>(0xE0 | (c >> 12 & 0x0F)));
-				s.push_back(static_cast<char>(0x80 | (c >>  6 & 0x3F)));
-				s.push_back(static_cast<char>(0x80 | (c       & 0x3F)));
+				case '\\': c = '\\'; break;
+				case '"':  c = '"';  break;
+				case 'n':  c = '\n'; break;
+				case 'r':  c = '\r'; break;
+				case 't':  c = '\t'; break;
+				case 'u':  hexDigs = 4; break;
+				case 'U':  hexDigs = 8; break;
+				default: return false;
 			}
-			else if (c <= 0x10FFFF)
+
+			next = esc + 2;
+			if (hexDigs == 0)
+				return true;
+
+			if (end - next < hexDigs)
+				return false;
+
+			c = 0;
+			for (int i{0}; i < hexDigs; ++i)
 			{
-				s.push_back(static_cast<char>(0xF0 | (c >> 18 & 0x07)));
-				s.push_back(static_cast<char>(0x80 | (c >> 12 & 0x3F)));
-				s.push_back(static_cast<char>(0x80 | (c >>  6 & 0x3F)));
-				s.push_back(static_cast<char>(0x80 | (c       & 0x3F)));
+				const char h{*next++};
+				c *= 16;
+				if      ('0' <= h && h <= '9') c += static_cast<char32_t>(h - '0');
+				else if ('A' <= h && h <= 'F') c += static_cast<char32_t>(h - 'A' + 10);
+				else if ('a' <= h && h <= 'f') c += static_cast<char32_t>(h - 'a' + 10);
+				else return false;
 			}
-			else
-				return false;
 
 			return true;
 		}
+
+		static std::size_t utf8Size(char32_t c)
+		{
+			if (c <= 0x7F)
+				return 1;
+			if (c <= 0x7FF)
+				return 2;
+			if (0xD800 <= c && c <= 0xDFFF)
+				return 0;
+			if (c <= 0xFFFF)
+				return 3;
+			if (c <= 0x10FFFF)
+				return 4;
+			return 0;
+		}
+
+		static char* writeUtf8(char* out, char32_t c)
+		{
+			switch (utf8Size(c))
+			{
+				case 1:
+					*out++ = static_cast<char>(c);
+					break;
+				case 2:
+					*out++ = static_cast<char>(0xC0 | (c >> 6 & 0x1F));
+					*out++ = static_cast<char>(0x80 | (c      & 0x3F));
+					break;
+				case 3:
+					*out++ = static_cast<char>(0xE0 | (c >> 12 & 0x0F));
+					*out++ = static_cast<char>(0x80 | (c >>  6 & 0x3F));
+					*out++ = static_cast<char>(0x80 | (c       & 0x3F));
+					break;
+				case 4:
+					*out++ = static_cast<char>(0xF0 | (c >> 18 & 0x07));
+					*out++ = static_cast<char>(0x80 | (c >> 12 & 0x3F));
+					*out++ = static_cast<char>(0x80 | (c >>  6 & 0x3F));
+					*out++ = static_cast<char>(0x80 | (c       & 0x3F));
+					break;
+			}
+			return out;
+		}
+};
+
+
+static_assert(static_cast<std::size_t>(Token::Type::strEscaped) + 1
+	== std::tuple_size_v<decltype(Stats::tokens)>);
+
+
+// The scanner of a token, selected by its first character.
+enum class TokenStart : std::uint8_t
+{
+	other,
+	dec,
+	zero,
+	no,
+	yes,
+	str
 };
 
+constexpr std::array<TokenStart, 256> makeTokenStarts()
+{
+	std::array<TokenStart, 256> starts{};
+
+	for (int c{'1'}; c <= '9'; ++c)
+		starts[c] = TokenStart::dec;
+
+	starts['-'] = TokenStart::dec;
+	starts['0'] = TokenStart::zero;
+	starts['n'] = TokenStart::no;
+	starts['y'] = TokenStart::yes;
+	starts['"'] = TokenStart::str;
+	return starts;
+}
+
+inline constexpr std::array<TokenStart, 256> tokenStarts{makeTokenStarts()};
+
 
 class Tokenizer
 {
@@ -590,7 +982,7 @@ class Tokenizer
 
 		Tokenizer() = default;
 
-		explicit Tokenizer(Stream stream, bool skipUtf8Bom = false) :
+		constexpr explicit Tokenizer(Stream stream, bool skipUtf8Bom = false) :
 			stream_{std::move(stream)}
 		{
 			if (skipUtf8Bom
@@ -600,67 +992,89 @@ class Tokenizer
 				stream_.skip(3);
 		}
 
-		std::size_t pos() const
+		constexpr std::size_t pos() const
 		{
 			return stream_.pos();
 		}
 
-		Token get()
+		// Limits the size of the following tokens. A longer token
+		// is bad, and is not scanned beyond the limit. Zero means
+		// unlimited.
+		constexpr void limit(std::size_t maxTokenSize)
+		{
+			maxTokenSize_ = maxTokenSize;
+		}
+
+		KCV_CONSTEXPR Token get()
 		{
-			while (isWs(stream_.peek()))
-				stream_.skip();
+			KCV_STATS(const std::size_t scanPos{stream_.pos()};)
+
+			stream_.skipClass(wsClass);
 
 			tokenPos_ = stream_.pos();
+			KCV_STATS(threadStats().bytes += tokenPos_ - scanPos;)
 
 			if (stream_.eof())
 				return make(Type::eof);
 
-			switch (stream_.peek())
-			{
-				case '-':
-				case '1':
-				case '2':
-				case '3':
-				case '4':
-				case '5':
-				case '6':
-				case '7':
-				case '8':
-				case '9':
+			if (maxTokenSize_ == 0 || stream_.end() - tokenPos_ <= maxTokenSize_)
+				return scan();
+
+			// One more byte is visible, to detect a longer token
+			const std::size_t end{stream_.end()};
+			stream_.setEnd(tokenPos_ + maxTokenSize_ + 1);
+			const Token token{scan()};
+			stream_.setEnd(end);
+
+			if (token.size() > maxTokenSize_)
+				return {stream_.data(), tokenPos_, token.size(), Type::bad};
+
+			return token;
+		}
+
+	private:
+
+		Stream stream_{};
+		std::size_t tokenPos_{0};
+		std::size_t maxTokenSize_{0};
+
+		KCV_CONSTEXPR Token scan()
+		{
+			switch (tokenStarts[static_cast<unsigned char>(stream_.peek())])
+			{
+				case TokenStart::dec:
 					return scanDec();
-				case '0':
+				case TokenStart::zero:
 					return (stream_.peek(1) == 'x')
 						? scanHex()
 						: scanDec();
-				case 'n':
+				case TokenStart::no:
 					return (stream_.peek(1) == 'o' && stream_.peek(2) != ':')
 						? scanNo()
 						: scanOther();
-				case 'y':
+				case TokenStart::yes:
 					return (stream_.peek(1) == 'e' && stream_.peek(2) == 's' && stream_.peek(3) != ':')
 						? scanYes()
 						: scanOther();
-				case '"':
+				case TokenStart::str:
 					return scanString();
 				default:
 					return scanOther();
 			}
 		}
 
-	private:
-
-		Stream stream_{};
-		std::size_t tokenPos_{0};
-
-		Token make(Type type, bool isWsTerminated = false) const
+		KCV_CONSTEXPR Token make(Type type, bool isWsTerminated = false) const
 		{
 			if (isWsTerminated && !stream_.eof() && !isWs(stream_.peek()))
 				type = Type::bad;
 
+			KCV_STATS(++threadStats().tokens[static_cast<std::size_t>(type)];)
+			KCV_STATS(threadStats().bytes += stream_.pos() - tokenPos_;)
+
 			return {stream_.data(), tokenPos_, stream_.pos() - tokenPos_, type};
 		}
 
-		Token scanDec()
+		KCV_CONSTEXPR Token scanDec()
 		{
 			Type type{Type::numIntPos};
 
@@ -688,7 +1102,7 @@ class Tokenizer
 			return make(type, true);
 		}
 
-		Token scanHex()
+		KCV_CONSTEXPR Token scanHex()
 		{
 			stream_.skip(2);
 
@@ -698,25 +1112,31 @@ class Tokenizer
 			return make(Type::numHex, true);
 		}
 
-		Token scanNo()
+		KCV_CONSTEXPR Token scanNo()
 		{
 			stream_.skip(2);
 			return make(Type::boolNo, true);
 		}
 
-		Token scanYes()
+		KCV_CONSTEXPR Token scanYes()
 		{
 			stream_.skip(3);
 			return make(Type::boolYes, true);
 		}
 
-		Token scanString()
+		KCV_CONSTEXPR Token scanString()
 		{
 			Type type{Type::strLiteral};
 
 			stream_.skip();
-			while (!stream_.eof() && stream_.peek() != '"')
+			while (true)
 			{
+				// Runs of plain ASCII are skipped in bulk
+				stream_.skipClass(plainClass);
+
+				if (stream_.eof() || stream_.peek() == '"')
+					break;
+
 				if (stream_.accept('\\'))
 				{
 					type = Type::strEscaped;
@@ -734,17 +1154,16 @@ class Tokenizer
 			return make(type, true);
 		}
 
-		Token scanOther()
+		KCV_CONSTEXPR Token scanOther()
 		{
 			if (isAlpha(stream_.peek()))
 			{
-				stream_.skip();
-				while (isKeyChar(stream_.peek()))
-					stream_.skip();
+				stream_.skipClass(keyCharClass);
 				if (stream_.peek() == ':')
 				{
 					Token token{make(Type::key)};
 					stream_.skip();
+					KCV_STATS(++threadStats().bytes;)
 					return token;
 				}
 			}
@@ -753,6 +1172,59 @@ class Tokenizer
 };
 
 
+class Limiter
+{
+	// Applies ParseLimits to the tokens of a parse loop.
+
+	public:
+
+		constexpr explicit Limiter(const ParseLimits& limits) :
+			limits_{limits}
+		{}
+
+		constexpr bool acceptData(std::string_view data) const
+		{
+			return isWithin(data.size(), limits_.maxDataSize);
+		}
+
+		// Begins a new item, after itemCount previous items.
+		constexpr bool acceptKey(const Token& token, std::size_t itemCount)
+		{
+			keyPos_ = token.pos();
+			valueCount_ = 0;
+
+			return isWithin(itemCount + 1, limits_.maxItemCount)
+				&& isWithin(token.size(), limits_.maxKeySize)
+				&& isWithin(token.size() + 1, limits_.maxItemSize);
+		}
+
+		constexpr bool acceptValue(const Token& token)
+		{
+			return isWithin(++valueCount_, limits_.maxValueCount)
+				&& isWithin(token.pos() + token.size() - keyPos_, limits_.maxItemSize);
+		}
+
+		// Accounts for memory that is about to be allocated.
+		constexpr bool acceptMemory(std::size_t size)
+		{
+			memory_ += size;
+			return isWithin(memory_, limits_.maxMemory);
+		}
+
+	private:
+
+		ParseLimits limits_;
+		std::size_t keyPos_{0};
+		std::size_t valueCount_{0};
+		std::size_t memory_{0};
+
+		static constexpr bool isWithin(std::size_t size, std::size_t limit)
+		{
+			return limit == 0 || size <= limit;
+		}
+};
+
+
 class Appender
 {
 	public:
@@ -849,11 +1321,68 @@ class Appender
 			return rawString(value.data(), value.size());
 		}
 
+		// Reserves the estimated size of the given values,
+		// so that they can be appended without reallocation.
+		template<typename... T>
+		void reserve(const T&... values)
+		{
+			target_.reserve(target_.size() + (0 + ... + sizeHint(values)));
+		}
+
 	private:
 
 		std::string& target_;
 
-		void rawSeparator()
+		// Size estimates, including the separator.
+		// Strings are assumed to contain no escapes.
+
+		static std::size_t sizeHint(const Whitespace& value)
+		{
+			return static_cast<std::size_t>(std::max(value.count, 0));
+		}
+
+		static std::size_t sizeHint(const bool&)
+		{
+			return 4;
+		}
+
+		template<typename T, IsInt<T> = true>
+		static std::size_t sizeHint(const T&)
+		{
+			return 1 + std::numeric_limits<T>::digits10 + 2;
+		}
+
+		template<typename T>
+		static std::size_t sizeHint(const IntValue<T>& value)
+		{
+			return 1 + std::numeric_limits<T>::digits10 + 2
+				+ static_cast<std::size_t>(std::clamp(value.width, 0, 24));
+		}
+
+		template<typename T, IsFloat<T> = true>
+		static std::size_t sizeHint(const T&)
+		{
+			return 1 + 6 + 8;
+		}
+
+		template<typename T>
+		static std::size_t sizeHint(const FloatValue<T>& value)
+		{
+			const std::size_t precision{static_cast<std::size_t>(std::clamp(value.precision, 1, 24))};
+			return value.isFixed ? 1 + 24 + precision : 1 + precision + 8;
+		}
+
+		static std::size_t sizeHint(const char* const& value)
+		{
+			return sizeHint(std::string_view{value});
+		}
+
+		static std::size_t sizeHint(const std::string_view& value)
+		{
+			return 1 + value.size() + 2;
+		}
+
+		void rawSeparator()
 		{
 			if (!target_.empty() && !isWs(target_.back()))
 				target_.push_back(' ');
@@ -874,75 +1403,85 @@ class Appender
 
 		bool rawString(const char* data, std::size_t count)
 		{
-			Stream stream{data, count};
-			std::size_t escCount{0};
+			// Validates and escapes in a single pass. Clean spans
+			// are copied in bulk. Blocks of plain ASCII characters
+			// are skipped eight bytes at a time. On failure, the
+			// target is restored to its previous size.
 
-			while (!stream.eof())
-			{
-				if (stream.accept('"') || stream.accept('\\'))
-					++escCount;
-				else if (!stream.acceptScalar())
-					return false;
-			}
+			const std::size_t oldSize{target_.size()};
 
 			rawSeparator();
+			target_.reserve(target_.size() + count + 2);
 			target_.push_back('"');
 
-			if (escCount == 0)
-				target_.append(data, count);
-			else
+			std::size_t spanPos{0};
+			std::size_t pos{0};
+
+			while (pos < count)
 			{
-				for (std::size_t i{0}; i < count; ++i)
+				if (count - pos >= 8 && isPlainBlock(data + pos))
+				{
+					pos += 8;
+					continue;
+				}
+
+				const char c{data[pos]};
+				if (c == '"' || c == '\\')
+				{
+					target_.append(data + spanPos, pos - spanPos);
+					target_.push_back('\\');
+					spanPos = pos++;
+				}
+				else if (static_cast<unsigned char>(c) <= 0x7F)
 				{
-					if (data[i] == '"' || data[i] == '\\')
-						target_.push_back('\\');
-					target_.push_back(data[i]);
+					++pos;
+				}
+				else
+				{
+					Stream stream{data, count, pos};
+					if (!stream.acceptScalar())
+					{
+						target_.resize(oldSize);
+						return false;
+					}
+					pos = stream.pos();
 				}
 			}
 
+			target_.append(data + spanPos, count - spanPos);
 			target_.push_back('"');
 			return true;
 		}
-};
-
 
-class Lookup
-{
-	public:
-
-		struct Less
+		static bool isPlainBlock(const char* data)
 		{
-			const char* data;
+			// Checks eight bytes for non-ASCII characters,
+			// double quotes, and backslashes, without branching.
+			// https://graphics.stanford.edu/~seander/bithacks.html#ValueInWord
 
-			bool operator()(const Lookup& a, const Lookup& b) const
-			{
-				return a.keyView(data) < b.keyView(data);
-			}
+			constexpr std::uint64_t ones{0x0101010101010101u};
+			constexpr std::uint64_t highs{0x8080808080808080u};
 
-			bool operator()(const Lookup& a, const std::string_view& b) const
-			{
-				return a.keyView(data) < b;
-			}
-		};
+			std::uint64_t word;
+			std::memcpy(&word, data, sizeof(word));
 
-		struct Equal
-		{
-			const char* data;
+			const std::uint64_t quotes{word ^ (ones * '"')};
+			const std::uint64_t slashes{word ^ (ones * '\\')};
 
-			bool operator()(const Lookup& a, const Lookup& b) const
-			{
-				return a.keyView(data) == b.keyView(data);
-			}
+			return ((word
+				| ((quotes  - ones) & ~quotes)
+				| ((slashes - ones) & ~slashes)) & highs) == 0;
+		}
+};
 
-			bool operator()(const Lookup& a, const std::string_view& b) const
-			{
-				return a.keyView(data) == b;
-			}
-		};
+
+class Lookup
+{
+	public:
 
 		Lookup() = default;
 
-		Lookup(std::size_t keyPos, std::size_t keySize, std::size_t itemSize)
+		constexpr Lookup(std::size_t keyPos, std::size_t keySize, std::size_t itemSize)
 		{
 			if (keyPos > 0xFFFFFFFFu || keySize > 0xFFu || itemSize > 0xFFFFFFu)
 				return;
@@ -951,21 +1490,44 @@ class Lookup
 			sizes_ = static_cast<std::uint32_t>(keySize | (itemSize << 8));
 		}
 
-		explicit operator bool() const
+		constexpr explicit operator bool() const
 		{
 			return sizes_ > 0;
 		}
 
-		std::string_view keyView(const char* data) const
+		constexpr std::size_t keyPos() const
+		{
+			return pos_;
+		}
+
+		constexpr std::size_t keySize() const
+		{
+			return sizes_ & 0xFF;
+		}
+
+		constexpr std::size_t itemSize() const
+		{
+			return sizes_ >> 8;
+		}
+
+		constexpr std::string_view keyView(const char* data) const
 		{
 			return {data + pos_, sizes_ & 0xFF};
 		}
 
-		std::string_view valView(const char* data) const
+		constexpr std::string_view valView(const char* data) const
+		{
+			return {data + valPos(), endPos() - valPos()};
+		}
+
+		constexpr std::size_t valPos() const
 		{
-			const std::size_t valPos{pos_ + (sizes_ & 0xFF) + 1};
-			const std::size_t valEnd{pos_ + (sizes_ >> 8)};
-			return {data + valPos, valEnd - valPos};
+			return pos_ + (sizes_ & 0xFF) + 1;
+		}
+
+		constexpr std::size_t endPos() const
+		{
+			return pos_ + (sizes_ >> 8);
 		}
 
 	private:
@@ -977,353 +1539,3838 @@ class Lookup
 };
 
 
-// Public types
-// ------------
+struct LookupLess
+{
+	// Compares the key bytes from the given depth onward
+	const char* data;
+	std::size_t depth;
+
+	bool operator()(const Lookup& a, const Lookup& b) const
+	{
+		return a.keyView(data).substr(depth) < b.keyView(data).substr(depth);
+	}
+};
 
-class Document;
-class Item
+struct LookupEqual
 {
-	friend Document;
+	const char* data;
+	std::size_t depth;
 
-	public:
+	bool operator()(const Lookup& a, const Lookup& b) const
+	{
+		return a.keyView(data).substr(depth) == b.keyView(data).substr(depth);
+	}
+};
 
-		// Checks if the item is active after construction,
-		// or if the most recent read or write was successul.
-		explicit operator bool() const
-		{
-			return values_ != nullptr && isOk_;
-		}
+// Sorts a range of lookups by key, comparing only the key bytes
+// from the given depth onward. Returns false if two keys are equal,
+// in which case the order is unspecified. Used at compile time,
+// where std::sort is not available.
+constexpr bool insertionSortLookups(Lookup* begin, Lookup* end, const char* data, std::size_t depth)
+{
+	for (Lookup* it{begin}; it != end; ++it)
+	{
+		const Lookup lookup{*it};
+		const std::string_view key{lookup.keyView(data).substr(depth)};
 
-		// Reads the next value and assigns it to a standard bool,
-		// integral, floating-point, string, or string_view variable.
-		// If the read fails, the target variable is left unchanged.
-		// A string_view cannot contain any escape sequence and
-		// remains valid until the item is altered.
-		// Resets the write position.
-		template<typename T>
-		Item& operator>>(T& target)
+		Lookup* hole{it};
+		for (; hole != begin; --hole)
 		{
-			if (values_ == nullptr)
-				return *this;
+			const std::string_view prev{(hole - 1)->keyView(data).substr(depth)};
 
-			Tokenizer tokenizer{Stream{values_->data(), values_->size(), readPos_}};
-			isOk_ = tokenizer.get().read(target);
-			readPos_ = tokenizer.pos();
-			isReading_ = true;
-			return *this;
+			if (prev == key)
+				return false;
+			if (prev < key)
+				break;
 
+			*hole = *(hole - 1);
 		}
+		*hole = lookup;
+	}
 
-		// Appends a standard bool, integral, floating-point,
-		// string, or string_view value. Invalid values are ignored.
-		// Within strings, any double quote or backslash is escaped.
-		// Resets the read position.
-		template<typename T>
-		Item& operator<<(const T& value)
-		{
-			if (values_ == nullptr)
-				return *this;
+	return true;
+}
 
-			if (isReading_)
-				values_->clear();
+// Retrieves the radix sort bucket of a lookup, which is
+// the key byte at the given depth plus one, or zero if
+// the key ends before.
+constexpr std::size_t lookupBucket(const Lookup& lookup, const char* data, std::size_t depth)
+{
+	const std::string_view key{lookup.keyView(data)};
+	return depth < key.size() ? static_cast<unsigned char>(key[depth]) + 1u : 0u;
+}
 
-			Appender appender{*values_};
-			isOk_ = appender.append(value);
-			readPos_ = 0;
-			isReading_ = false;
-			return *this;
-		}
+// Sorts a range of lookups by key, with an in-place MSD radix sort
+// (American flag sort) on the key bytes from the given depth onward.
+// Duplicate keys are detected while counting, because they end at
+// the same depth in the same bucket. Returns false if two keys
+// are equal, in which case the order is unspecified.
+constexpr bool sortLookups(Lookup* begin, Lookup* end, const char* data, std::size_t depth = 0)
+{
+	// Bucket 0 holds the key which ends at the current depth
+	constexpr std::size_t bucketCount{257};
+	constexpr std::ptrdiff_t smallCount{128};
+
+	while (end - begin > 1)
+	{
+		// Small ranges are cheaper to compare directly
+		if (end - begin <= smallCount)
+		{
+			if (isConstantEvaluated())
+				return insertionSortLookups(begin, end, data, depth);
 
-	private:
+			std::sort(begin, end, LookupLess{data, depth});
+			return std::adjacent_find(begin, end, LookupEqual{data, depth}) == end;
+		}
 
-		std::string* values_{nullptr};
-		std::size_t readPos_{0};
-		bool isReading_{true};
-		bool isOk_{true};
+		std::array<std::size_t, bucketCount> counts{};
+		std::array<std::size_t, bucketCount> heads{};
+		std::array<std::size_t, bucketCount> tails{};
 
-		Item() = default;
+		for (Lookup* it{begin}; it != end; ++it)
+			++counts[lookupBucket(*it, data, depth)];
 
-		explicit Item(std::string* values) :
-			values_{values}
-		{}
-};
+		if (counts[0] > 1)
+			return false;
 
+		// Skip a byte which is shared by all keys
+		const std::size_t count{static_cast<std::size_t>(end - begin)};
+		if (counts[lookupBucket(*begin, data, depth)] == count)
+		{
+			++depth;
+			continue;
+		}
 
-class Document
-{
-	// A general purpose class which owns and manages its data.
-	// New items can be inserted. Values can be read and written.
-	// Item lookup has logarithmic complexity.
+		std::size_t sum{0};
+		for (std::size_t b{0}; b < bucketCount; ++b)
+		{
+			heads[b] = sum;
+			sum += counts[b];
+			tails[b] = sum;
+		}
 
-	public:
+		// Move each lookup directly into its bucket
+		for (std::size_t b{0}; b < bucketCount; ++b)
+			while (heads[b] < tails[b])
+			{
+				Lookup lookup{begin[heads[b]]};
+				std::size_t target{lookupBucket(lookup, data, depth)};
 
-		// Constructs an empty document.
-		Document() :
-			isOk_{true}
-		{}
+				while (target != b)
+				{
+					const Lookup displaced{begin[heads[target]]};
+					begin[heads[target]++] = lookup;
+					lookup = displaced;
+					target = lookupBucket(lookup, data, depth);
+				}
 
-		// Parses a KCV string. If the parsing fails, or the non-zero
-		// maxItemCount is exceeded, an empty document is constructed.
-		explicit Document(std::string_view data, std::size_t maxItemCount = 0)
-		{
-			Map items{};
+				begin[heads[b]++] = lookup;
+			}
 
-			Tokenizer tokenizer{Stream{data}, true};
-			std::size_t keyPos{0};
-			std::size_t keySize{0};
+		// Recurse into the smaller buckets, and continue with the
+		// largest one, so that the recursion depth stays logarithmic
+		std::size_t largest{1};
+		for (std::size_t b{2}; b < bucketCount; ++b)
+			if (counts[b] > counts[largest])
+				largest = b;
 
-			while (true)
+		for (std::size_t b{1}; b < bucketCount; ++b)
+			if (b != largest && counts[b] > 1)
 			{
-				const Token token{tokenizer.get()};
+				Lookup* const first{begin + (tails[b] - counts[b])};
+				if (!sortLookups(first, first + counts[b], data, depth + 1))
+					return false;
+			}
 
-				if (token.isKey() || token.isEof())
-				{
-					if (keySize != 0)
-					{
-						if (maxItemCount > 0 && items.size() >= maxItemCount)
-							return;
+		Lookup* const first{begin + (tails[largest] - counts[largest])};
+		begin = first;
+		end = first + counts[largest];
+		++depth;
+	}
 
-						const std::size_t valPos{keyPos + keySize + 1};
-						const std::size_t valSize{token.pos() - valPos};
+	return true;
+}
 
-						auto result{items.try_emplace(
-							std::string{data.substr(keyPos, keySize)},
-							std::string{data.substr(valPos, valSize)} )};
 
-						if (!result.second)
-							return;
-					}
+// Merges two adjacent sorted ranges of lookups without allocating,
+// by rotating each run of the second range into place. Returns
+// false if two keys are equal, in which case the order is unspecified.
+inline bool mergeLookups(Lookup* begin, Lookup* middle, Lookup* end, const char* data)
+{
+	const LookupLess less{data, 0};
+	const LookupEqual equal{data, 0};
+	Lookup* const first{begin};
+
+	while (begin != middle && middle != end)
+	{
+		// Skip the lookups of the first range which stay in place
+		begin = std::upper_bound(begin, middle, *middle, less);
+		if (begin != first && equal(*(begin - 1), *middle))
+			return false;
+		if (begin == middle)
+			break;
+
+		// Move the run of the second range which precedes them
+		Lookup* const run{std::lower_bound(middle, end, *begin, less)};
+		if (run != end && equal(*run, *begin))
+			return false;
+
+		std::rotate(begin, middle, run);
+		begin += run - middle;
+		middle = run;
+	}
+
+	return true;
+}
 
-					if (token.isEof())
-						break;
 
-					keyPos = token.pos();
-					keySize = token.size();
-				}
-				else if (!token.isValue())
-					return;
-				else if (keySize == 0)
-					return;
+class Value
+{
+	// A tokenized value, recorded on the value tape
+	// of a DocumentView in the order of the data.
+
+	public:
+
+		struct Less
+		{
+			bool operator()(const Value& a, std::size_t pos) const
+			{
+				return a.pos_ < pos;
 			}
+		};
 
-			items_ = std::move(items);
-			isOk_ = true;
-		}
+		Value() = default;
 
-		// Checks if the constructor accepted the data string.
-		explicit operator bool() const
+		constexpr explicit Value(const Token& token)
 		{
-			return isOk_;
+			if (token.pos() > 0xFFFFFFFFu || token.size() > 0xFFFFFFu)
+				return;
+
+			pos_  = static_cast<std::uint32_t>(token.pos());
+			info_ = static_cast<std::uint32_t>(
+				static_cast<std::size_t>(token.type()) | (token.size() << 8));
 		}
 
-		// Retrieves an item. If the key does not exist, a new item is
-		// inserted. If the key is invalid, an inactive item is returned.
-		Item operator[](std::string_view key)
+		constexpr explicit operator bool() const
 		{
-			auto found{items_.find(key)};
-			if (found != items_.end())
-				return Item{&(found->second)};
+			return info_ > 0xFFu;
+		}
 
-			if (key.empty())
-				return {};
+		constexpr std::size_t pos() const
+		{
+			return pos_;
+		}
 
-			if (!isAlpha(key[0]))
+		// Copies the value to a different position.
+		constexpr Value moved(std::size_t pos) const
+		{
+			if (pos > 0xFFFFFFFFu)
 				return {};
 
-			for (std::size_t i{1}; i < key.size(); ++i)
-				if (!isKeyChar(key[i]))
-					return {};
-
-			auto emplaced{items_.try_emplace(std::string{key}, std::string{})};
-			return Item{&(emplaced.first->second)};
+			Value value{*this};
+			value.pos_ = static_cast<std::uint32_t>(pos);
+			return value;
 		}
 
-		// Writes the document to a string.
-		// The items are ordered lexicographically.
-		std::string dump() const
+		constexpr Token token(const char* data) const
 		{
-			std::size_t size{0};
-
-			for(const auto& [key, values] : items_)
-			{
-				size += key.size();
-				size += 1;
-				if (!values.empty() && !isWs(values.front()))
-					size += 1;
-				size += values.size();
-				if (values.empty() || values.back() != '\n')
-					size += 1;
-			}
-
-			std::string out{};
-			out.reserve(size);
-
-			for(const auto& [key, values] : items_)
-			{
-				out.append(key);
-				out.push_back(':');
-				if (!values.empty() && !isWs(values.front()))
-					out.push_back(' ');
-				out.append(values);
-				if (values.empty() || values.back() != '\n')
-					out.push_back('\n');
-			}
-
-			return out;
+			return {data, pos_, info_ >> 8, static_cast<Token::Type>(info_ & 0xFF)};
 		}
 
 	private:
 
-		using Map = std::map<std::string, std::string, std::less<>>;
+		std::uint32_t pos_{0};
+		std::uint32_t info_{0};
+		// Token size in FFFFFF00
+		// Token type in 000000FF
+};
 
-		Map items_{};
+
+// Incremental parsing
+// -------------------
+
+struct Edit
+{
+	// The byte ranges of the items which differ between an old and a
+	// new version of the data. Both ranges begin at the same key.
+	// The rest of the data is equal, apart from the shift of the
+	// items after the ranges.
+
+	std::size_t begin{0};
+	std::size_t oldEnd{0};
+	std::size_t newEnd{0};
+	std::size_t prefixSize{0};
+	std::size_t suffixSize{0};
+
+	// Measures the common prefix and suffix, which do not overlap.
+	// Equal blocks are skipped with memcmp first.
+	Edit(std::string_view oldData, std::string_view newData)
+	{
+		constexpr std::size_t blockSize{256};
+		const std::size_t size{std::min(oldData.size(), newData.size())};
+
+		while (size - prefixSize >= blockSize
+			&& std::memcmp(oldData.data() + prefixSize, newData.data() + prefixSize, blockSize) == 0)
+			prefixSize += blockSize;
+
+		while (prefixSize < size && oldData[prefixSize] == newData[prefixSize])
+			++prefixSize;
+
+		const char* const oldEnd{oldData.data() + oldData.size()};
+		const char* const newEnd{newData.data() + newData.size()};
+
+		while (size - prefixSize - suffixSize >= blockSize
+			&& std::memcmp(oldEnd - suffixSize - blockSize, newEnd - suffixSize - blockSize, blockSize) == 0)
+			suffixSize += blockSize;
+
+		while (suffixSize < size - prefixSize && *(oldEnd - suffixSize - 1) == *(newEnd - suffixSize - 1))
+			++suffixSize;
+	}
+
+	bool isEqual(std::string_view oldData, std::string_view newData) const
+	{
+		return prefixSize == oldData.size() && prefixSize == newData.size();
+	}
+
+	// Tokenizes both versions in lockstep, from the key at the given
+	// position, until they reach the same key or end within the common
+	// suffix. The tokenizer does not look back, so all later tokens
+	// are equal as well. Returns false if the new data no longer has
+	// a key at the position, or if it is invalid.
+	bool find(std::string_view oldData, std::string_view newData, std::size_t keyPos)
+	{
+		Tokenizer oldTokenizer{Stream{oldData.data(), oldData.size(), keyPos}};
+		Tokenizer newTokenizer{Stream{newData.data(), newData.size(), keyPos}};
+
+		Token oldToken{oldTokenizer.get()};
+		Token newToken{newTokenizer.get()};
+
+		if (!oldToken.isKey() || !newToken.isKey())
+			return false;
+
+		const std::size_t oldSuffixPos{oldData.size() - suffixSize};
+
+		while (true)
+		{
+			if (newToken.type() == Token::Type::bad)
+				return false;
+
+			// Compare the positions as if the old data were shifted
+			const std::size_t oldPos{oldToken.pos() + newData.size()};
+			const std::size_t newPos{newToken.pos() + oldData.size()};
+
+			const bool isBoundary{(oldToken.isKey() || oldToken.isEof()) && oldToken.type() == newToken.type()};
+			if (isBoundary && oldPos == newPos && oldToken.pos() >= oldSuffixPos)
+				break;
+
+			if (oldPos <= newPos && !oldToken.isEof())
+				oldToken = oldTokenizer.get();
+			if (newPos <= oldPos && !newToken.isEof())
+				newToken = newTokenizer.get();
+		}
+
+		begin = keyPos;
+		oldEnd = oldToken.pos();
+		newEnd = newToken.pos();
+		return true;
+	}
+
+	// Shifts a position after the old range into the new data.
+	std::size_t shift(std::size_t pos) const
+	{
+		return pos - oldEnd + newEnd;
+	}
+};
+
+
+// Value cache
+// -----------
+
+// Identifies a cached arithmetic type, or returns zero if the
+// type cannot be cached. An index is used instead of the address
+// of a per-type constant, which identical code folding may merge.
+template<typename T>
+constexpr std::uint8_t cacheTypeIndex()
+{
+	constexpr bool isType[]{
+		std::is_same_v<T, bool>,
+		std::is_same_v<T, char>,
+		std::is_same_v<T, signed char>,
+		std::is_same_v<T, unsigned char>,
+		std::is_same_v<T, wchar_t>,
+		std::is_same_v<T, char16_t>,
+		std::is_same_v<T, char32_t>,
+		std::is_same_v<T, short>,
+		std::is_same_v<T, unsigned short>,
+		std::is_same_v<T, int>,
+		std::is_same_v<T, unsigned int>,
+		std::is_same_v<T, long>,
+		std::is_same_v<T, unsigned long>,
+		std::is_same_v<T, long long>,
+		std::is_same_v<T, unsigned long long>,
+		std::is_same_v<T, float>,
+		std::is_same_v<T, double>,
+		std::is_same_v<T, long double>};
+
+	for (std::uint8_t i{0}; i < sizeof(isType); ++i)
+		if (isType[i])
+			return static_cast<std::uint8_t>(i + 1);
+
+	return 0;
+}
+
+class ValueCache
+{
+	// Remembers the most recently decoded bool, integral and
+	// floating-point values of a Document item, keyed by their
+	// position and type. The slots are allocated when the cache
+	// is enabled, and are not copied along with the item. While
+	// disabled, the cache is a null pointer, which every item
+	// of a Document carries.
+
+	public:
+
+		ValueCache() = default;
+		ValueCache(ValueCache&&) = default;
+		ValueCache& operator=(ValueCache&&) = default;
+
+		ValueCache(const ValueCache&) {}
+
+		ValueCache& operator=(const ValueCache&)
+		{
+			slots_.reset();
+			return *this;
+		}
+
+		bool isEnabled() const
+		{
+			return slots_ != nullptr;
+		}
+
+		void enable()
+		{
+			if (slots_ == nullptr)
+				slots_ = std::make_unique<Slots>();
+		}
+
+		void disable()
+		{
+			slots_.reset();
+		}
+
+		// Forgets all values, after the item has been altered.
+		void clear()
+		{
+			if (slots_ != nullptr)
+				*slots_ = Slots{};
+		}
+
+		// Retrieves a value that has been read from pos before,
+		// and the position after it. On a failed read, the target
+		// is left unchanged. Returns false if the value is unknown.
+		template<typename T>
+		bool find(std::size_t pos, T& target, std::size_t& endPos, bool& isOk) const
+		{
+			for (const Slot& slot : slots_->slots)
+			{
+				if (slot.type == cacheTypeIndex<T>() && slot.pos == pos)
+				{
+					if (slot.isOk)
+						std::memcpy(&target, slot.bytes, sizeof(T));
+					endPos = slot.endPos;
+					isOk = slot.isOk;
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// Stores a value, replacing the oldest slot.
+		template<typename T>
+		void insert(std::size_t pos, const T& value, std::size_t endPos, bool isOk)
+		{
+			static_assert(sizeof(T) <= sizeof(Slot::bytes));
+			static_assert(cacheTypeIndex<T>() != 0);
+
+			Slot& slot{slots_->slots[slots_->next]};
+			slots_->next = (slots_->next + 1) % slotCount;
+
+			slot.type = cacheTypeIndex<T>();
+			slot.pos = pos;
+			slot.endPos = endPos;
+			slot.isOk = isOk;
+			std::memcpy(slot.bytes, &value, sizeof(T));
+		}
+
+	private:
+
+		static constexpr std::size_t slotCount{4};
+
+		struct Slot
+		{
+			std::uint8_t type{0};
+			std::size_t pos{0};
+			std::size_t endPos{0};
+			bool isOk{false};
+			alignas(long double) unsigned char bytes[sizeof(long double)]{};
+		};
+
+		struct Slots
+		{
+			std::array<Slot, slotCount> slots{};
+			std::size_t next{0};
+		};
+
+		std::unique_ptr<Slots> slots_{};
+};
+
+// The mapped type of a Document.
+struct Values
+{
+	std::string text{};
+	ValueCache cache{};
+};
+
+
+// Public types
+// ------------
+
+template<typename I>
+class Range
+{
+	// A pair of iterators, for use in range-based for loops.
+
+	public:
+
+		Range(I begin, I end) :
+			begin_{begin},
+			end_{end}
+		{}
+
+		I begin() const
+		{
+			return begin_;
+		}
+
+		I end() const
+		{
+			return end_;
+		}
+
+	private:
+
+		I begin_{};
+		I end_{};
+};
+
+
+template<typename S>
+class TokenIterator
+{
+	// Iterates over the remaining values of an item in a single
+	// pass, yielding the raw Token of each. Stops before the first
+	// token that is not a value. The default instance is the end.
+
+	public:
+
+		using iterator_category = std::input_iterator_tag;
+		using value_type = Token;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const Token*;
+		using reference = const Token&;
+
+		TokenIterator() = default;
+
+		explicit TokenIterator(S source) :
+			source_{std::move(source)}
+		{
+			++(*this);
+		}
+
+		const Token& operator*() const
+		{
+			return token_;
+		}
+
+		const Token* operator->() const
+		{
+			return &token_;
+		}
+
+		TokenIterator& operator++()
+		{
+			token_ = next(source_);
+			isEnd_ = !token_.isValue();
+			return *this;
+		}
+
+		friend bool operator==(const TokenIterator& a, const TokenIterator& b)
+		{
+			return a.isEnd_ && b.isEnd_;
+		}
+
+		friend bool operator!=(const TokenIterator& a, const TokenIterator& b)
+		{
+			return !(a == b);
+		}
+
+	private:
+
+		S source_{};
+		Token token_{nullptr, 0, 0, Token::Type::eof};
+		bool isEnd_{true};
+
+		static Token next(Tokenizer& source)
+		{
+			return source.get();
+		}
+
+		template<typename V>
+		static Token next(V& source)
+		{
+			return source.next();
+		}
+};
+
+
+template<typename T, typename S>
+class ValueIterator
+{
+	// Reads the remaining values of an item into T in a single
+	// pass, without allocation unless T does. Stops before the
+	// first value that cannot be read. The default instance
+	// is the end.
+
+	public:
+
+		using iterator_category = std::input_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const T*;
+		using reference = const T&;
+
+		ValueIterator() = default;
+
+		explicit ValueIterator(S source) :
+			tokens_{std::move(source)}
+		{
+			read();
+		}
+
+		const T& operator*() const
+		{
+			return value_;
+		}
+
+		const T* operator->() const
+		{
+			return &value_;
+		}
+
+		ValueIterator& operator++()
+		{
+			++tokens_;
+			read();
+			return *this;
+		}
+
+		friend bool operator==(const ValueIterator& a, const ValueIterator& b)
+		{
+			return a.tokens_ == b.tokens_;
+		}
+
+		friend bool operator!=(const ValueIterator& a, const ValueIterator& b)
+		{
+			return !(a == b);
+		}
+
+	private:
+
+		TokenIterator<S> tokens_{};
+		T value_{};
+
+		void read()
+		{
+			if (tokens_ != TokenIterator<S>{} && !tokens_->read(value_))
+				tokens_ = TokenIterator<S>{};
+		}
+};
+
+
+class Document;
+class DocumentBuilder;
+template<typename, typename>
+class MapIterator;
+class ItemCursor;
+struct Change;
+using Patch = std::vector<Change>;
+inline bool apply(Document& doc, const Patch& patch);
+class InternedDocument;
+class Item
+{
+	friend Document;
+	friend DocumentBuilder;
+	friend InternedDocument;
+
+	template<typename, typename>
+	friend class MapIterator;
+
+	template<typename, typename, typename>
+	friend class MapSubtree;
+
+	public:
+
+		// Checks if the item is active after construction,
+		// or if the most recent read or write was successul.
+		explicit operator bool() const
+		{
+			return values_ != nullptr && isOk_;
+		}
+
+		// Reads the next value and assigns it to a standard bool,
+		// integral, floating-point, string, or string_view variable,
+		// or to a StringBuffer. If the read fails, the target
+		// variable is left unchanged.
+		// A string_view cannot contain any escape sequence and
+		// remains valid until the item is altered.
+		// Resets the write position.
+		template<typename T>
+		Item& operator>>(T& target)
+		{
+			if (values_ == nullptr)
+				return *this;
+
+			isOk_ = readNext(target);
+			isReading_ = true;
+			return *this;
+		}
+
+		// Reads the next values into several targets at once,
+		// as if they were read one after another. Stops at the
+		// first failed read, leaving the remaining targets unchanged.
+		template<typename... T>
+		Item& read(T&... targets)
+		{
+			if (values_ == nullptr)
+				return *this;
+
+			if (cache_ != nullptr && cache_->isEnabled())
+			{
+				isOk_ = (true && ... && readNext(targets));
+				isReading_ = true;
+				return *this;
+			}
+
+			Tokenizer tokenizer{Stream{values_->data(), values_->size(), readPos_}};
+			isOk_ = (true && ... && tokenizer.get().read(targets));
+			readPos_ = tokenizer.pos();
+			isReading_ = true;
+			return *this;
+		}
+
+		// Appends a standard bool, integral, floating-point,
+		// string, or string_view value. Invalid values are ignored.
+		// Within strings, any double quote or backslash is escaped.
+		// Resets the read position.
+		template<typename T>
+		Item& operator<<(const T& value)
+		{
+			if (values_ == nullptr)
+				return *this;
+
+			if (isReading_)
+				values_->clear();
+
+			if (cache_ != nullptr)
+				cache_->clear();
+
+			Appender appender{*values_};
+			isOk_ = appender.append(value);
+			readPos_ = 0;
+			isReading_ = false;
+			return *this;
+		}
+
+		// Appends several values at once, as if they were
+		// written one after another. Storage for all values
+		// is reserved up front. Invalid values are ignored.
+		template<typename... T>
+		Item& write(const T&... values)
+		{
+			if (values_ == nullptr)
+				return *this;
+
+			if (isReading_)
+				values_->clear();
+
+			if (cache_ != nullptr)
+				cache_->clear();
+
+			Appender appender{*values_};
+			appender.reserve(values...);
+
+			bool isOk{true};
+			((isOk = appender.append(values) && isOk), ...);
+
+			isOk_ = isOk;
+			readPos_ = 0;
+			isReading_ = false;
+			return *this;
+		}
+
+		// Replaces all values with a single value, in place. If the
+		// new text fits into the old values, it overwrites them, and
+		// is padded with spaces, so that the size of the values and
+		// the layout of a dump remain unchanged. Fixed-width values,
+		// such as hex(n, 16), always fit once written. Otherwise, the
+		// values grow as needed. The surrounding whitespace is kept.
+		// If the value is invalid, the item is unchanged.
+		// Resets the read and write positions.
+		template<typename T>
+		Item& set(const T& value)
+		{
+			if (values_ == nullptr)
+				return *this;
+
+			std::string& values{*values_};
+			const std::size_t oldSize{values.size()};
+
+			std::size_t begin{0};
+			while (begin < oldSize && isWs(values[begin]))
+				++begin;
+
+			std::size_t end{oldSize};
+			while (end > begin && isWs(values[end - 1]))
+				--end;
+
+			// Without old text, the whitespace is kept after the value
+			if (begin == end)
+				begin = end = 0;
+
+			// Format behind the old values, to reuse their capacity
+			values.push_back(' ');
+			const std::size_t textPos{values.size()};
+			Appender appender{values};
+			isOk_ = appender.append(value);
+			const std::size_t textSize{values.size() - textPos};
+
+			if (!isOk_)
+				values.resize(oldSize);
+			else if (textSize <= end - begin)
+			{
+				std::memcpy(values.data() + begin, values.data() + textPos, textSize);
+				std::fill(values.begin() + static_cast<std::ptrdiff_t>(begin + textSize),
+					values.begin() + static_cast<std::ptrdiff_t>(end), ' ');
+				values.resize(oldSize);
+			}
+			else
+			{
+				// Replace the old text, and move the new
+				// text in front of the trailing whitespace
+				values.erase(begin, end - begin);
+				std::rotate(values.begin() + static_cast<std::ptrdiff_t>(begin),
+					values.end() - static_cast<std::ptrdiff_t>(textSize),
+					values.end());
+				values.pop_back();
+			}
+
+			if (cache_ != nullptr)
+				cache_->clear();
+
+			readPos_ = 0;
+			isReading_ = true;
+			return *this;
+		}
+
+		// Iterates over the values from the read position onward,
+		// reading each into a T, until a value cannot be read. The
+		// range is single-pass, and remains valid until the item
+		// is altered. The read position of the item is unchanged.
+		template<typename T>
+		Range<ValueIterator<T, Tokenizer>> values() const
+		{
+			return {ValueIterator<T, Tokenizer>{tokenizer()}, {}};
+		}
+
+		// Iterates over the raw tokens of the values from the read
+		// position onward, with the same validity as values().
+		Range<TokenIterator<Tokenizer>> tokens() const
+		{
+			return {TokenIterator<Tokenizer>{tokenizer()}, {}};
+		}
+
+	private:
+
+		std::string* values_{nullptr};
+		ValueCache* cache_{nullptr};
+		std::size_t readPos_{0};
+		bool isReading_{true};
+		bool isOk_{true};
+
+		Item() = default;
+
+		explicit Item(std::string* values) :
+			values_{values}
+		{}
+
+		explicit Item(Values* values) :
+			values_{&(values->text)},
+			cache_{&(values->cache)}
+		{}
+
+		// An inactive item has no values
+		Tokenizer tokenizer() const
+		{
+			if (values_ == nullptr)
+				return {};
+
+			return Tokenizer{Stream{values_->data(), values_->size(), readPos_}};
+		}
+
+		// Reads the value at the read position, from the cache if
+		// it is enabled and has seen the value before.
+		template<typename T>
+		bool readNext(T& target)
+		{
+			constexpr bool isCacheable{cacheTypeIndex<T>() != 0};
+			const bool isCached{isCacheable &&
+				cache_ != nullptr && cache_->isEnabled()};
+
+			bool isOk{false};
+			if constexpr (isCacheable)
+				if (isCached && cache_->find(readPos_, target, readPos_, isOk))
+					return isOk;
+
+			Tokenizer tokenizer{Stream{values_->data(), values_->size(), readPos_}};
+			isOk = tokenizer.get().read(target);
+
+			if constexpr (isCacheable)
+				if (isCached)
+					cache_->insert(readPos_, target, tokenizer.pos(), isOk);
+
+			readPos_ = tokenizer.pos();
+			return isOk;
+		}
+};
+
+
+template<std::size_t, std::size_t>
+class DocumentView;
+class Overlay;
+class SubtreeView;
+class SourceIterator;
+class ItemView
+{
+	// Refers to the values of an item in the data string.
+	// If the document stores a value tape, it also refers to
+	// the tape, which is a member of the DocumentView. It then
+	// becomes invalid when the DocumentView is moved, assigned
+	// or destroyed, not only when the data string is.
+
+	friend Document;
+	friend Overlay;
+	friend SubtreeView;
+	friend SourceIterator;
+
+	template<typename, typename>
+	friend class MapIterator;
+
+	template<typename, typename, typename>
+	friend class MapSubtree;
+
+	template<std::size_t, std::size_t>
+	friend class DocumentView;
+
+	template<typename>
+	friend class TokenIterator;
+
+	public:
+
+		// Checks if the item is active after construction,
+		// or if the most recent read or write was successul.
+		explicit operator bool() const
+		{
+			return isOk_;
+		}
+
+		// Reads the next value and assigns it to a standard bool,
+		// integral, floating-point, string, or string_view variable,
+		// or to a StringBuffer. If the read fails, the target
+		// variable is left unchanged.
+		// A string_view cannot contain any escape sequence.
+		template<typename T>
+		ItemView& operator>>(T& target)
+		{
+			isOk_ = isOk_ && next().read(target);
+			return *this;
+		}
+
+		// Reads the next values into several targets at once,
+		// as if they were read one after another. Stops at the
+		// first failed read, leaving the remaining targets unchanged.
+		template<typename... T>
+		ItemView& read(T&... targets)
+		{
+			isOk_ = isOk_ && (true && ... && next().read(targets));
+			return *this;
+		}
+
+		// Counts the values, regardless of the read position.
+		// Has constant complexity if the document stores a
+		// value tape, and linear complexity otherwise.
+		std::size_t size() const
+		{
+			if (isTaped())
+				return static_cast<std::size_t>(end_ - begin_);
+
+			std::size_t count{0};
+			Tokenizer tokenizer{Stream{values_}};
+			while (tokenizer.get().isValue())
+				++count;
+			return count;
+		}
+
+		// Retrieves a copy of the item, positioned at the value with
+		// the given index. If the index is out of range, an inactive
+		// item is returned. Has the same complexity as size().
+		ItemView at(std::size_t index) const
+		{
+			if (!isActive_)
+				return {};
+
+			ItemView item{*this};
+			item.isOk_ = true;
+
+			if (isTaped())
+			{
+				if (index >= size())
+					return {};
+				item.next_ = begin_ + index;
+				return item;
+			}
+
+			item.tokenizer_ = Tokenizer{Stream{values_}};
+			for (std::size_t i{0}; i < index; ++i)
+				if (!item.tokenizer_.get().isValue())
+					return {};
+
+			Tokenizer peek{item.tokenizer_};
+			if (!peek.get().isValue())
+				return {};
+
+			return item;
+		}
+
+		// Iterates over the values from the read position onward,
+		// reading each into a T, until a value cannot be read. The
+		// range is single-pass. The read position of the item is
+		// unchanged.
+		template<typename T>
+		Range<ValueIterator<T, ItemView>> values() const
+		{
+			return {ValueIterator<T, ItemView>{*this}, {}};
+		}
+
+		// Iterates over the raw tokens of the values
+		// from the read position onward.
+		Range<TokenIterator<ItemView>> tokens() const
+		{
+			return {TokenIterator<ItemView>{*this}, {}};
+		}
+
+	private:
+
+		// Without a value tape, the values are tokenized on demand
+		std::string_view values_{};
+		Tokenizer tokenizer_{};
+
+		// With a value tape, the tokens are retrieved directly
+		const char* data_{nullptr};
+		const Value* begin_{nullptr};
+		const Value* next_{nullptr};
+		const Value* end_{nullptr};
+
+		bool isActive_{false};
+		bool isOk_{false};
+
+		ItemView() = default;
+
+		explicit ItemView(std::string_view values) :
+			values_{values},
+			tokenizer_{Stream{values}},
+			isActive_{true},
+			isOk_{true}
+		{}
+
+		ItemView(const char* data, const Value* begin, const Value* end) :
+			data_{data},
+			begin_{begin},
+			next_{begin},
+			end_{end},
+			isActive_{true},
+			isOk_{true}
+		{}
+
+		// Creates the item of a DocumentView lookup. If the tape
+		// is empty, the values are tokenized on demand instead.
+		static ItemView make(const char* data, const Lookup& lookup,
+			const Value* tapeBegin, const Value* tapeEnd)
+		{
+			if (tapeBegin == nullptr)
+				return ItemView{lookup.valView(data)};
+
+			// The values of an item are contiguous on the tape
+			const Value::Less less{};
+
+			return {data,
+				std::lower_bound(tapeBegin, tapeEnd, lookup.valPos(), less),
+				std::lower_bound(tapeBegin, tapeEnd, lookup.endPos(), less)};
+		}
+
+		bool isTaped() const
+		{
+			return data_ != nullptr;
+		}
+
+		Token next()
+		{
+			if (!isTaped())
+				return tokenizer_.get();
+
+			if (next_ == end_)
+				return {data_, 0, 0, Token::Type::eof};
+
+			return (next_++)->token(data_);
+		}
+};
+
+
+// Measures the size of a dumped item.
+inline std::size_t dumpSize(std::string_view key, std::string_view values)
+{
+	std::size_t size{key.size() + 1 + values.size()};
+	if (!values.empty() && !isWs(values.front()))
+		size += 1;
+	if (values.empty() || values.back() != '\n')
+		size += 1;
+	return size;
+}
+
+// Writes a dumped item, which is separated from the key by
+// whitespace, and ends with a newline. The output must have
+// room for dumpSize() bytes. Returns the end of the output.
+inline char* dumpItem(char* out, std::string_view key, std::string_view values)
+{
+	std::memcpy(out, key.data(), key.size());
+	out += key.size();
+	*out++ = ':';
+	if (!values.empty() && !isWs(values.front()))
+		*out++ = ' ';
+	std::memcpy(out, values.data(), values.size());
+	out += values.size();
+	if (values.empty() || values.back() != '\n')
+		*out++ = '\n';
+	return out;
+}
+
+
+template<typename It, typename I>
+class MapIterator
+{
+	// Iterates over the items of a Document in lexicographic order.
+	// Yields each key together with an Item, or with an ItemView
+	// if the document is const. The pair is returned by value, so
+	// the iterator is only an input iterator for the standard
+	// algorithms, although it can also be decremented.
+
+	friend Document;
+
+	template<typename, typename, typename>
+	friend class MapSubtree;
+
+	public:
+
+		using iterator_category = std::input_iterator_tag;
+		using value_type = std::pair<std::string_view, I>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = value_type;
+
+		MapIterator() = default;
+
+		value_type operator*() const
+		{
+			return {std::string_view{it_->first}.substr(offset_), makeItem(it_->second)};
+		}
+
+		MapIterator& operator++()
+		{
+			++it_;
+			return *this;
+		}
+
+		MapIterator operator++(int)
+		{
+			MapIterator old{*this};
+			++it_;
+			return old;
+		}
+
+		MapIterator& operator--()
+		{
+			--it_;
+			return *this;
+		}
+
+		MapIterator operator--(int)
+		{
+			MapIterator old{*this};
+			--it_;
+			return old;
+		}
+
+		friend bool operator==(const MapIterator& a, const MapIterator& b)
+		{
+			return a.it_ == b.it_;
+		}
+
+		friend bool operator!=(const MapIterator& a, const MapIterator& b)
+		{
+			return a.it_ != b.it_;
+		}
+
+	private:
+
+		It it_{};
+
+		// The length of a subtree prefix, which is
+		// removed from the yielded keys
+		std::size_t offset_{0};
+
+		explicit MapIterator(It it, std::size_t offset = 0) :
+			it_{it},
+			offset_{offset}
+		{}
+
+		static Item makeItem(Values& values)
+		{
+			return Item{&values};
+		}
+
+		static ItemView makeItem(const Values& values)
+		{
+			return ItemView{std::string_view{values.text}};
+		}
+};
+
+
+// A key which consists of a prefix and a relative key.
+// It is compared with the keys of a Document without
+// concatenating its parts.
+struct JoinedKey
+{
+	std::string_view prefix;
+	std::string_view key;
+
+	// Compares other with prefix + key
+	int compareTo(std::string_view other) const
+	{
+		const int cmp{other.substr(0, prefix.size()).compare(prefix)};
+		if (cmp != 0)
+			return cmp;
+
+		return other.substr(prefix.size()).compare(key);
+	}
+
+	friend bool operator<(std::string_view a, const JoinedKey& b)
+	{
+		return b.compareTo(a) < 0;
+	}
+
+	friend bool operator<(const JoinedKey& a, std::string_view b)
+	{
+		return a.compareTo(b) > 0;
+	}
+};
+
+
+template<typename D, typename It, typename I>
+class MapSubtree
+{
+	// The items of a Document whose keys begin with a common
+	// prefix, followed by a dot. For example, the subtree "net"
+	// contains the key "net.tcp.port" as "tcp.port". Holds the
+	// range of these items in the map, and a copy of the prefix.
+	// A mutable subtree inserts new items into the document and
+	// extends its range. Other insertions into the document are
+	// not necessarily included, and erasing or reparsing items
+	// invalidates the subtree, so it must be retrieved again.
+
+	friend Document;
+
+	public:
+
+		using Iterator = MapIterator<It, I>;
+
+		// Constructs an inactive subtree without items.
+		MapSubtree() = default;
+
+		// Checks if the subtree was retrieved with a valid prefix.
+		explicit operator bool() const
+		{
+			return doc_ != nullptr;
+		}
+
+		// Counts the items, with linear complexity.
+		std::size_t size() const
+		{
+			return static_cast<std::size_t>(std::distance(begin_, end_));
+		}
+
+		// Retrieves an item by its key relative to the prefix. If the
+		// subtree is mutable and the key does not exist, a new item is
+		// inserted. If the key is invalid, an inactive item is returned.
+		I operator[](std::string_view key)
+		{
+			if constexpr (std::is_const_v<D>)
+				return find(key);
+			else
+				return insert(key);
+		}
+
+		// Retrieves a read-only item, without inserting it.
+		ItemView operator[](std::string_view key) const
+		{
+			return find(key);
+		}
+
+		// Retrieves a read-only item by its key relative to the prefix,
+		// without inserting it. If the key does not exist, an inactive
+		// item is returned.
+		ItemView find(std::string_view key) const
+		{
+			if (doc_ == nullptr || key.empty())
+				return {};
+
+			return doc_->findItem(JoinedKey{prefix_, key});
+		}
+
+		// Iterates over the items in lexicographic order, yielding
+		// each key relative to the prefix. The iterators remain
+		// valid as long as the items.
+		Iterator begin() const
+		{
+			return Iterator{begin_, prefix_.size()};
+		}
+
+		Iterator end() const
+		{
+			return Iterator{end_, prefix_.size()};
+		}
+
+		// Retrieves the items whose keys relative to the prefix are
+		// lexicographically greater than or equal to lo, and less than hi.
+		Range<Iterator> range(std::string_view lo, std::string_view hi) const
+		{
+			if (doc_ == nullptr)
+				return {begin(), end()};
+
+			// Every key with the prefix sorts before end_
+			const It begin{doc_->items_.lower_bound(JoinedKey{prefix_, lo})};
+			const It end{hi <= lo ? begin : doc_->items_.lower_bound(JoinedKey{prefix_, hi})};
+			return {Iterator{begin, prefix_.size()}, Iterator{end, prefix_.size()}};
+		}
+
+		// Retrieves a nested subtree. The given prefix is relative
+		// to the prefix of this subtree.
+		MapSubtree subtree(std::string_view prefix) const
+		{
+			if (doc_ == nullptr || prefix.empty())
+				return {};
+
+			return {doc_, prefix_, prefix};
+		}
+
+	private:
+
+		D* doc_{nullptr};
+		It begin_{};
+		It end_{};
+		std::string prefix_{};
+		std::string key_{};
+
+		MapSubtree(D* doc, std::string_view parent, std::string_view prefix) :
+			doc_{doc}
+		{
+			prefix_.reserve(parent.size() + prefix.size() + 1);
+			prefix_.append(parent);
+			prefix_.append(prefix);
+
+			// All keys which continue with prefix + '.' are sorted
+			// between prefix + '.' and prefix + '/'
+			prefix_.push_back('/');
+			end_ = doc->items_.lower_bound(prefix_);
+			prefix_.back() = '.';
+			begin_ = doc->items_.lower_bound(prefix_);
+		}
+
+		Item insert(std::string_view key)
+		{
+			if (doc_ == nullptr || key.empty())
+				return {};
+
+			key_.assign(prefix_);
+			key_.append(key);
+
+			const It found{doc_->findOrInsert(key_)};
+			if (found == doc_->items_.end())
+				return {};
+
+			// A new first item extends the range
+			if (std::next(found) == begin_)
+				begin_ = found;
+
+			return Iterator::makeItem(found->second);
+		}
+};
+
+
+class Document
+{
+	// A general purpose class which owns and manages its data.
+	// New items can be inserted. Values can be read and written.
+	// Item lookup has logarithmic complexity.
+
+	friend DocumentBuilder;
+	friend Overlay;
+	friend ItemCursor;
+	friend bool apply(Document& doc, const Patch& patch);
+
+	template<typename, typename, typename>
+	friend class MapSubtree;
+
+#ifdef KCV_ENABLE_LOADER
+	friend class Loader;
+#endif
+
+	using Map = std::map<std::string, Values, std::less<>>;
+
+	public:
+
+		using Iterator = MapIterator<Map::iterator, Item>;
+		using ConstIterator = MapIterator<Map::const_iterator, ItemView>;
+		using Subtree = MapSubtree<Document, Map::iterator, Item>;
+		using ConstSubtree = MapSubtree<const Document, Map::const_iterator, ItemView>;
+
+		// Constructs an empty document.
+		Document() :
+			isOk_{true}
+		{}
+
+		// Parses a KCV string. If the parsing fails, or the non-zero
+		// maxItemCount is exceeded, an empty document is constructed.
+		explicit Document(std::string_view data, std::size_t maxItemCount = 0)
+		{
+			ParseLimits limits{};
+			limits.maxItemCount = maxItemCount;
+			parse(data, limits);
+		}
+
+		// Parses a KCV string. If the parsing fails, or any of the
+		// limits is exceeded, an empty document is constructed.
+		// The parsing stops at the first exceeded limit.
+		Document(std::string_view data, const ParseLimits& limits)
+		{
+			parse(data, limits);
+		}
+
+		// Checks if the constructor accepted the data string.
+		explicit operator bool() const
+		{
+			return isOk_;
+		}
+
+		// Replaces the items with those of an edited version of the
+		// data, such as a file after a small change. The document must
+		// have been parsed from oldData, and not altered since. Only
+		// the items around the change are tokenized again. The result
+		// is the same as constructing a new document from newData with
+		// the original limits, also on failure. The Item instances of
+		// the keys which are still present remain valid, and read the
+		// new values, unless the reparse falls back to a full parse:
+		// on failure, with a memory limit, or if the edit cannot be
+		// located. All other Item instances, iterators and subtrees
+		// become invalid.
+		bool reparse(std::string_view oldData, std::string_view newData)
+		{
+			if (!isOk_ || !reparseEdit(oldData, newData))
+			{
+				items_.clear();
+				checkpoints_.clear();
+				isOk_ = false;
+				parse(newData, limits_);
+			}
+
+			return isOk_;
+		}
+
+		// Retrieves an item. If the key does not exist, a new item is
+		// inserted. If the key is invalid, an inactive item is returned.
+		Item operator[](std::string_view key)
+		{
+			const auto found{findOrInsert(key)};
+			if (found == items_.end())
+				return {};
+
+			return Item{&(found->second)};
+		}
+
+		// Retrieves a read-only item, without inserting it. If the key
+		// does not exist, an inactive item is returned. Concurrent calls
+		// are safe, as long as no thread alters the document.
+		ItemView find(std::string_view key) const
+		{
+			return findItem(key);
+		}
+
+		// Removes an item. Returns false if the key does not exist.
+		// Other items, and their Item instances, remain valid.
+		bool erase(std::string_view key)
+		{
+			auto found{items_.find(key)};
+			if (found == items_.end())
+				return false;
+
+			items_.erase(found);
+			return true;
+		}
+
+		// Enables or disables the decoded value cache. While enabled,
+		// every item retrieved with operator[] remembers its recently
+		// read bool, integral and floating-point values, so that
+		// reading an unchanged value again skips the conversion.
+		// Writing to an item clears its cache. Disabling the cache
+		// releases its memory. Whether enabled or not, every item
+		// stores a pointer to its cache, which is null until used.
+		void cacheValues(bool isEnabled)
+		{
+			isCaching_ = isEnabled;
+
+			if (!isEnabled)
+				for (auto& [key, values] : items_)
+					values.cache.disable();
+		}
+
+		// Iterates over the items in lexicographic order, without
+		// copying. The iterators remain valid as long as the document.
+		Iterator begin()
+		{
+			return Iterator{items_.begin()};
+		}
+
+		Iterator end()
+		{
+			return Iterator{items_.end()};
+		}
+
+		ConstIterator begin() const
+		{
+			return ConstIterator{items_.begin()};
+		}
+
+		ConstIterator end() const
+		{
+			return ConstIterator{items_.end()};
+		}
+
+		// Retrieves the items whose keys are lexicographically
+		// greater than or equal to lo, and less than hi.
+		Range<Iterator> range(std::string_view lo, std::string_view hi)
+		{
+			const auto begin{items_.lower_bound(lo)};
+			const auto end{hi <= lo ? begin : items_.lower_bound(hi)};
+			return {Iterator{begin}, Iterator{end}};
+		}
+
+		Range<ConstIterator> range(std::string_view lo, std::string_view hi) const
+		{
+			const auto begin{items_.lower_bound(lo)};
+			const auto end{hi <= lo ? begin : items_.lower_bound(hi)};
+			return {ConstIterator{begin}, ConstIterator{end}};
+		}
+
+		// Retrieves the items whose keys begin with the given prefix
+		// and a dot, with two logarithmic searches. The mutable subtree
+		// inserts new items into this document. If the prefix is not
+		// a valid key, an inactive subtree is returned.
+		Subtree subtree(std::string_view prefix)
+		{
+			if (!isKey(prefix))
+				return {};
+
+			return {this, {}, prefix};
+		}
+
+		ConstSubtree subtree(std::string_view prefix) const
+		{
+			if (!isKey(prefix))
+				return {};
+
+			return {this, {}, prefix};
+		}
+
+		// Writes the document to a string.
+		// The items are ordered lexicographically.
+		std::string dump() const
+		{
+			std::size_t size{0};
+
+			for(const auto& [key, values] : items_)
+				size += dumpSize(key, values.text);
+
+			std::string out(size, '\0');
+			char* end{out.data()};
+
+			for(const auto& [key, values] : items_)
+				end = dumpItem(end, key, values.text);
+
+			return out;
+		}
+
+	private:
+
+		// A key position is recorded every checkpointInterval bytes
+		// of the parsed data, so that reparse() can tokenize from the
+		// last checkpoint before an edit instead of the beginning.
+		static constexpr std::size_t checkpointInterval{4096};
+
+		// The estimated size of a map node, for the memory limit
+		static constexpr std::size_t nodeMemory{sizeof(Map::value_type) + 4 * sizeof(void*)};
+
+		Map items_{};
+		ParseLimits limits_{};
+		std::vector<std::size_t> checkpoints_{};
+		bool isOk_{false};
+		bool isCaching_{false};
+
+		// Retrieves an item, or inserts it if the key does not exist.
+		// Returns the end of the map if the key is invalid.
+		Map::iterator findOrInsert(std::string_view key)
+		{
+			auto found{items_.find(key)};
+			KCV_STATS(countLookup(found != items_.end());)
+
+			if (found == items_.end())
+			{
+				if (!isKey(key))
+					return found;
+
+				KCV_STATS(StatsTimer timer{threadStats().insertNanoseconds};)
+				found = items_.try_emplace(std::string{key}).first;
+				KCV_STATS(countInsertion(found->first, found->second.text);)
+			}
+
+			if (isCaching_)
+				found->second.cache.enable();
+			return found;
+		}
+
+		// Retrieves a read-only item by a key or a JoinedKey
+		template<typename K>
+		ItemView findItem(const K& key) const
+		{
+			auto found{items_.find(key)};
+			KCV_STATS(countLookup(found != items_.end());)
+
+			if (found != items_.end())
+				return ItemView{std::string_view{found->second.text}};
+
+			return {};
+		}
+
+		// Parses a KCV string into this empty document. Returns the
+		// position where the parsing failed, or npos on success.
+		std::size_t parse(std::string_view data, const ParseLimits& limits)
+		{
+			limits_ = limits;
+
+			Limiter limiter{limits};
+			if (!limiter.acceptData(data))
+				return 0;
+
+			Map items{};
+			std::vector<std::size_t> checkpoints{};
+			std::size_t checkpointPos{0};
+
+			Tokenizer tokenizer{Stream{data}, true};
+			tokenizer.limit(limits.maxItemSize);
+			std::size_t keyPos{0};
+			std::size_t keySize{0};
+
+			while (true)
+			{
+				const Token token{tokenizer.get()};
+
+				if (token.isKey() || token.isEof())
+				{
+					if (keySize != 0)
+					{
+						const std::size_t valPos{keyPos + keySize + 1};
+						const std::size_t valSize{token.pos() - valPos};
+
+						// Estimates the map node and the string buffers
+						if (!limiter.acceptMemory(nodeMemory + keySize + valSize))
+							return keyPos;
+
+						KCV_STATS(StatsTimer timer{threadStats().insertNanoseconds};)
+						auto result{items.try_emplace(
+							std::string{data.substr(keyPos, keySize)},
+							Values{std::string{data.substr(valPos, valSize)}} )};
+
+						if (!result.second)
+							return keyPos;
+
+						KCV_STATS(countInsertion(result.first->first, result.first->second.text);)
+					}
+
+					if (token.isEof())
+						break;
+
+					if (!limiter.acceptKey(token, items.size()))
+						return token.pos();
+
+					addCheckpoint(checkpoints, checkpointPos, token.pos());
+					keyPos = token.pos();
+					keySize = token.size();
+				}
+				else if (!token.isValue())
+					return token.pos();
+				else if (keySize == 0)
+					return token.pos();
+				else if (!limiter.acceptValue(token))
+					return token.pos();
+			}
+
+			items_ = std::move(items);
+			checkpoints_ = std::move(checkpoints);
+			isOk_ = true;
+			return std::string_view::npos;
+		}
+
+		static void addCheckpoint(std::vector<std::size_t>& checkpoints, std::size_t& lastPos, std::size_t keyPos)
+		{
+			// The beginning of the data is an implicit checkpoint,
+			// so small documents need no allocation
+			if (keyPos >= lastPos + checkpointInterval)
+			{
+				checkpoints.push_back(keyPos);
+				lastPos = keyPos;
+			}
+		}
+
+		// Applies an edit by tokenizing only the changed items.
+		// Returns false if the edit cannot be applied, in which
+		// case the items are unspecified.
+		bool reparseEdit(std::string_view oldData, std::string_view newData)
+		{
+			// The memory estimate covers all items, so
+			// only a full parse can check it
+			Limiter limiter{limits_};
+			if (limits_.maxMemory != 0 || !limiter.acceptData(newData))
+				return false;
+
+			Edit edit{oldData, newData};
+
+			if (edit.isEqual(oldData, newData))
+				return true;
+
+			// The changed items begin at the last key before the change,
+			// which is found by tokenizing from the last checkpoint
+			const auto checkpoint{std::lower_bound(checkpoints_.begin(), checkpoints_.end(), edit.prefixSize)};
+			const std::size_t scanPos{checkpoint == checkpoints_.begin() ? 0 : *(checkpoint - 1)};
+			Tokenizer tokenizer{Stream{oldData.data(), oldData.size(), scanPos}, scanPos == 0};
+			std::size_t keyPos{std::string_view::npos};
+
+			for (Token token{tokenizer.get()}; token.pos() < edit.prefixSize; token = tokenizer.get())
+			{
+				if (token.isKey())
+					keyPos = token.pos();
+				else if (!token.isValue())
+					return false;
+			}
+
+			if (keyPos == std::string_view::npos || !edit.find(oldData, newData, keyPos))
+				return false;
+
+			// Extract the old items, to reuse the nodes of the
+			// keys which are kept, along with their Item instances
+			Map removed{};
+			tokenizer = Tokenizer{Stream{oldData.data(), oldData.size(), edit.begin}};
+
+			for (Token token{tokenizer.get()}; token.pos() < edit.oldEnd; token = tokenizer.get())
+			{
+				if (!token.isKey())
+					continue;
+
+				auto found{items_.find(token.text())};
+				if (found == items_.end())
+					return false;
+
+				removed.insert(items_.extract(found));
+			}
+
+			// Insert the new items, and record their checkpoints with
+			// the same spacing as a parse, after the previous checkpoint
+			auto first{std::lower_bound(checkpoints_.begin(), checkpoints_.end(), edit.begin)};
+			auto last{std::lower_bound(first, checkpoints_.end(), edit.oldEnd)};
+
+			std::vector<std::size_t> added{};
+			std::size_t checkpointPos{first == checkpoints_.begin() ? 0 : *(first - 1)};
+
+			std::size_t keySize{0};
+			tokenizer = Tokenizer{Stream{newData.data(), newData.size(), edit.begin}};
+			tokenizer.limit(limits_.maxItemSize);
+
+			while (true)
+			{
+				const Token token{tokenizer.get()};
+				const bool isEnd{token.pos() >= edit.newEnd};
+
+				if (token.isKey() || isEnd)
+				{
+					if (keySize != 0)
+					{
+						const std::size_t valPos{keyPos + keySize + 1};
+						const std::string_view key{newData.substr(keyPos, keySize)};
+						const std::string_view values{newData.substr(valPos, token.pos() - valPos)};
+
+						const auto kept{removed.find(key)};
+
+						if (kept == removed.end())
+						{
+							if (!items_.try_emplace(std::string{key}, Values{std::string{values}}).second)
+								return false;
+						}
+						else
+						{
+							Map::node_type node{removed.extract(kept)};
+							node.mapped().text.assign(values);
+							node.mapped().cache.clear();
+
+							if (!items_.insert(std::move(node)).inserted)
+								return false;
+						}
+					}
+
+					if (isEnd)
+						break;
+
+					// The item count is checked once all items are inserted
+					if (!limiter.acceptKey(token, 0))
+						return false;
+
+					addCheckpoint(added, checkpointPos, token.pos());
+					keyPos = token.pos();
+					keySize = token.size();
+				}
+				else if (!token.isValue() || !limiter.acceptValue(token))
+					return false;
+			}
+
+			if (limits_.maxItemCount != 0 && items_.size() > limits_.maxItemCount)
+				return false;
+
+			// Replace the checkpoints of the changed items,
+			// and shift the later ones
+			for (auto it{last}; it != checkpoints_.end(); ++it)
+				*it = edit.shift(*it);
+
+			first = checkpoints_.erase(first, last);
+			checkpoints_.insert(first, added.begin(), added.end());
+			return true;
+		}
+};
+
+
+class DocumentBuilder
+{
+	// Collects the items of a new Document. If the keys are
+	// appended in ascending order, the document is constructed
+	// in linear time: every item is inserted with a hint at the
+	// end of the map, so the insertion is amortized constant and
+	// needs no key search. The tree is still rebalanced.
+
+	public:
+
+		// Constructs an empty builder and allocates storage for
+		// reserveCount items. If requireSorted is true, every key
+		// must be greater than the previously appended key.
+		explicit DocumentBuilder(std::size_t reserveCount = 0, bool requireSorted = false) :
+			requireSorted_{requireSorted}
+		{
+			items_.reserve(reserveCount);
+		}
+
+		// Checks if all appended keys have been accepted.
+		explicit operator bool() const
+		{
+			return isOk_;
+		}
+
+		// Appends a new item. If the key is invalid, or does not
+		// follow the previous key although requireSorted is true,
+		// an inactive item is returned and the builder fails.
+		// The item remains valid until the next append or build.
+		Item append(std::string_view key)
+		{
+			if (!isOk_)
+				return {};
+
+			if (!isKey(key))
+			{
+				isOk_ = false;
+				return {};
+			}
+
+			if (!items_.empty() && key <= items_.back().first)
+			{
+				if (requireSorted_ || key == items_.back().first)
+				{
+					isOk_ = false;
+					return {};
+				}
+				isSorted_ = false;
+			}
+
+			items_.emplace_back(std::string{key}, std::string{});
+			return Item{&(items_.back().second)};
+		}
+
+		// Moves the items into a new Document and resets the builder.
+		// Unordered keys are sorted first. If the builder has failed,
+		// or a key was appended twice, an empty document is returned
+		// which evaluates to false.
+		Document build()
+		{
+			Document doc{};
+			doc.isOk_ = isOk_;
+
+			if (isOk_ && !isSorted_)
+			{
+				std::sort(items_.begin(), items_.end(), KeyLess{});
+				auto found{std::adjacent_find(items_.begin(), items_.end(), KeyEqual{})};
+				doc.isOk_ = (found == items_.end());
+			}
+
+			if (doc.isOk_)
+			{
+				KCV_STATS(StatsTimer timer{threadStats().insertNanoseconds};)
+				for (Entry& entry : items_)
+					doc.items_.emplace_hint(doc.items_.end(),
+						std::move(entry.first), Values{std::move(entry.second)});
+
+				KCV_STATS(for (const auto& [key, values] : doc.items_)
+					countInsertion(key, values.text);)
+			}
+
+			items_.clear();
+			isSorted_ = true;
+			isOk_ = true;
+			return doc;
+		}
+
+	private:
+
+		using Entry = std::pair<std::string, std::string>;
+
+		struct KeyLess
+		{
+			bool operator()(const Entry& a, const Entry& b) const
+			{
+				return a.first < b.first;
+			}
+		};
+
+		struct KeyEqual
+		{
+			bool operator()(const Entry& a, const Entry& b) const
+			{
+				return a.first == b.first;
+			}
+		};
+
+		std::vector<Entry> items_{};
+		bool requireSorted_{false};
+		bool isSorted_{true};
+		bool isOk_{true};
+};
+
+
+class Writer
+{
+	// Appends items to a caller-owned string in the order of the
+	// calls, without building a Document. The output can be parsed
+	// again as long as no key is written twice, which is optionally
+	// checked. The caller may consume and clear the string between
+	// writes, for example to flush it to a file.
+
+	public:
+
+		// Constructs a writer for the target string. If checkKeys is
+		// true, the keys are remembered in a compact hash set, and a
+		// key that has been written before is rejected.
+		explicit Writer(std::string& target, bool checkKeys = false) :
+			target_{&target},
+			checkKeys_{checkKeys}
+		{}
+
+		// Checks if all written keys and values have been accepted.
+		explicit operator bool() const
+		{
+			return isOk_;
+		}
+
+		// Appends an item with the given values, as a single line.
+		// If the key is invalid or was written before, nothing is
+		// appended. Invalid values are ignored, like in Item::write().
+		// Returns false and fails the writer in either case.
+		template<typename... T>
+		bool write(std::string_view key, const T&... values)
+		{
+			if (!isKey(key) || (checkKeys_ && !insertKey(key)))
+			{
+				isOk_ = false;
+				return false;
+			}
+
+			target_->reserve(target_->size() + key.size() + 2);
+			target_->append(key);
+			target_->push_back(':');
+
+			Appender appender{*target_};
+			appender.reserve(values...);
+
+			bool isOk{true};
+			((isOk = appender.append(values) && isOk), ...);
+
+			target_->push_back('\n');
+			isOk_ = isOk_ && isOk;
+			return isOk;
+		}
+
+	private:
+
+		struct Slot
+		{
+			std::uint64_t hash{0};
+			std::size_t pos{0};
+			std::size_t size{0};
+		};
+
+		std::string* target_;
+		std::string keys_{};
+		std::vector<Slot> slots_{};
+		std::size_t count_{0};
+		bool checkKeys_;
+		bool isOk_{true};
+
+		// FNV-1a
+		static std::uint64_t hashKey(std::string_view key)
+		{
+			std::uint64_t hash{0xCBF29CE484222325u};
+			for (const char c : key)
+			{
+				hash ^= static_cast<unsigned char>(c);
+				hash *= 0x100000001B3u;
+			}
+			return hash;
+		}
+
+		// Inserts a key into the open-addressing hash set, with linear
+		// probing. The key bytes are stored contiguously in keys_.
+		// Returns false if the key is already present.
+		bool insertKey(std::string_view key)
+		{
+			if (2 * (count_ + 1) > slots_.size())
+				rehash(std::max<std::size_t>(64, 2 * slots_.size()));
+
+			const std::uint64_t hash{hashKey(key)};
+			const std::size_t mask{slots_.size() - 1};
+
+			for (std::size_t i{hash & mask}; ; i = (i + 1) & mask)
+			{
+				Slot& slot{slots_[i]};
+
+				if (slot.size == 0)
+				{
+					slot = {hash, keys_.size(), key.size()};
+					keys_.append(key);
+					++count_;
+					return true;
+				}
+
+				if (slot.hash == hash && std::string_view{keys_}.substr(slot.pos, slot.size) == key)
+					return false;
+			}
+		}
+
+		void rehash(std::size_t size)
+		{
+			std::vector<Slot> slots(size);
+			const std::size_t mask{size - 1};
+
+			for (const Slot& slot : slots_)
+			{
+				if (slot.size == 0)
+					continue;
+
+				std::size_t i{slot.hash & mask};
+				while (slots[i].size != 0)
+					i = (i + 1) & mask;
+				slots[i] = slot;
+			}
+
+			slots_ = std::move(slots);
+		}
+};
+
+
+class KeyTable
+{
+	// Interns validated keys, so that many InternedDocument
+	// instances can refer to the same key by a compact id.
+	// Ids are assigned in the order of interning, and remain
+	// valid as long as the table. Not thread-safe: intern()
+	// alters the table, so it must not run concurrently with
+	// any other use of the table, including the InternedDocument
+	// constructor and operator[] with a string key.
+
+	public:
+
+		using Id = std::uint32_t;
+
+		// The id of an invalid or unknown key.
+		static constexpr Id none{0xFFFFFFFFu};
+
+		// Constructs an empty table.
+		KeyTable() = default;
+
+		// Retrieves the id of a key, and interns the key if it is
+		// not yet known. If the key is invalid, none is returned.
+		Id intern(std::string_view key)
+		{
+			auto found{ids_.find(key)};
+			if (found != ids_.end())
+				return found->second;
+
+			if (!isKey(key) || keys_.size() >= none)
+				return none;
+
+			const Id id{static_cast<Id>(keys_.size())};
+			auto emplaced{ids_.try_emplace(std::string{key}, id)};
+			keys_.push_back(emplaced.first->first);
+			return id;
+		}
+
+		// Retrieves the id of a known key, without interning.
+		// If the key is unknown, none is returned.
+		Id find(std::string_view key) const
+		{
+			auto found{ids_.find(key)};
+			return found != ids_.end() ? found->second : none;
+		}
+
+		// Retrieves the key of an id. If the id is
+		// unknown, an empty string_view is returned.
+		std::string_view key(Id id) const
+		{
+			return id < keys_.size() ? keys_[id] : std::string_view{};
+		}
+
+		// Counts the interned keys.
+		std::size_t size() const
+		{
+			return keys_.size();
+		}
+
+	private:
+
+		// The map nodes never move, so the views remain valid
+		std::map<std::string, Id, std::less<>> ids_{};
+		std::vector<std::string_view> keys_{};
+};
+
+
+class InternedDocument
+{
+	// A Document whose keys are stored once in a shared KeyTable,
+	// instead of once per document. The items are stored in a vector
+	// sorted by key id, so that a lookup by id is a binary search over
+	// integers, and an item costs no node allocation. Inserting an item
+	// moves the others, so it invalidates all Item instances of the
+	// document. The table must outlive the document, and may intern
+	// keys while the document is parsed or altered.
+
+	public:
+
+		// Constructs an empty document.
+		explicit InternedDocument(KeyTable& table) :
+			table_{&table},
+			isOk_{true}
+		{}
+
+		// Parses a KCV string. If the parsing fails, or the non-zero
+		// maxItemCount is exceeded, an empty document is constructed.
+		// The keys are interned even if the parsing fails.
+		InternedDocument(KeyTable& table, std::string_view data, std::size_t maxItemCount = 0) :
+			table_{&table}
+		{
+			Items items{};
+
+			Tokenizer tokenizer{Stream{data}, true};
+			KeyTable::Id id{KeyTable::none};
+			std::size_t valPos{0};
+
+			while (true)
+			{
+				const Token token{tokenizer.get()};
+
+				if (token.isKey() || token.isEof())
+				{
+					if (id != KeyTable::none)
+					{
+						if (maxItemCount > 0 && items.size() >= maxItemCount)
+							return;
+
+						items.emplace_back(id, std::string{data.substr(valPos, token.pos() - valPos)});
+					}
+
+					if (token.isEof())
+						break;
+
+					id = table.intern(token.text());
+					valPos = token.pos() + token.size() + 1;
+
+					if (id == KeyTable::none)
+						return;
+				}
+				else if (!token.isValue())
+					return;
+				else if (id == KeyTable::none)
+					return;
+			}
+
+			// Sort items and reject duplicate keys
+			std::sort(items.begin(), items.end(), EntryLess{});
+			if (std::adjacent_find(items.begin(), items.end(), EntryEqual{}) != items.end())
+				return;
+
+			// Many documents are held at once, so the
+			// growth capacity of the vector is released
+			items.shrink_to_fit();
+			items_ = std::move(items);
+			isOk_ = true;
+		}
+
+		// Checks if the constructor accepted the data string.
+		explicit operator bool() const
+		{
+			return isOk_;
+		}
+
+		// Retrieves an item. If the key does not exist, a new item is
+		// inserted and the key is interned. If the key is invalid,
+		// an inactive item is returned.
+		Item operator[](std::string_view key)
+		{
+			return (*this)[table_->intern(key)];
+		}
+
+		// Retrieves an item by the id of its key, which avoids the
+		// string comparisons. If the item does not exist, a new item
+		// is inserted. If the id is unknown, an inactive item is returned.
+		Item operator[](KeyTable::Id id)
+		{
+			auto found{std::lower_bound(items_.begin(), items_.end(), id, EntryLess{})};
+			if (found != items_.end() && found->first == id)
+				return Item{&(found->second)};
+
+			if (id >= table_->size())
+				return {};
+
+			return Item{&(items_.emplace(found, id, std::string{})->second)};
+		}
+
+		// Writes the document to a string.
+		// The items are ordered lexicographically.
+		std::string dump() const
+		{
+			std::vector<std::pair<std::string_view, const std::string*>> items{};
+			items.reserve(items_.size());
+			std::size_t size{0};
+
+			for (const auto& [id, values] : items_)
+			{
+				items.emplace_back(table_->key(id), &values);
+				size += dumpSize(items.back().first, values);
+			}
+
+			std::sort(items.begin(), items.end());
+
+			std::string out(size, '\0');
+			char* end{out.data()};
+
+			for (const auto& [key, values] : items)
+				end = dumpItem(end, key, *values);
+
+			return out;
+		}
+
+	private:
+
+		using Entry = std::pair<KeyTable::Id, std::string>;
+		using Items = std::vector<Entry>;
+
+		struct EntryLess
+		{
+			bool operator()(const Entry& a, const Entry& b) const
+			{
+				return a.first < b.first;
+			}
+
+			bool operator()(const Entry& a, KeyTable::Id b) const
+			{
+				return a.first < b;
+			}
+		};
+
+		struct EntryEqual
+		{
+			bool operator()(const Entry& a, const Entry& b) const
+			{
+				return a.first == b.first;
+			}
+		};
+
+		KeyTable* table_;
+		Items items_{};
+		bool isOk_{false};
+};
+
+
+class SubtreeView
+{
+	// A read-only view of the items of a DocumentView whose keys
+	// begin with a common prefix, followed by a dot. For example,
+	// the subtree "net" contains the key "net.tcp.port" as "tcp.port".
+	// Does not copy any data, and remains valid as long as the document.
+	// The items are a contiguous range of the sorted document,
+	// so lookups have logarithmic complexity.
+
+	template<std::size_t, std::size_t>
+	friend class DocumentView;
+
+	public:
+
+		class Iterator
+		{
+			// Iterates over the items in lexicographic order.
+			// Yields each key relative to the prefix, together
+			// with an ItemView. The pair is returned by value, so
+			// the iterator is only an input iterator for the
+			// standard algorithms, although it supports the
+			// arithmetic of a random access iterator.
+
+			friend SubtreeView;
+
+			public:
+
+				using iterator_category = std::input_iterator_tag;
+				using value_type = std::pair<std::string_view, ItemView>;
+				using difference_type = std::ptrdiff_t;
+				using pointer = void;
+				using reference = value_type;
+
+				Iterator() = default;
+
+				value_type operator*() const
+				{
+					return {it_->keyView(data_).substr(offset_),
+						ItemView::make(data_, *it_, tapeBegin_, tapeEnd_)};
+				}
+
+				value_type operator[](difference_type n) const
+				{
+					return *(*this + n);
+				}
+
+				Iterator& operator++()
+				{
+					++it_;
+					return *this;
+				}
+
+				Iterator operator++(int)
+				{
+					Iterator old{*this};
+					++it_;
+					return old;
+				}
+
+				Iterator& operator--()
+				{
+					--it_;
+					return *this;
+				}
+
+				Iterator operator--(int)
+				{
+					Iterator old{*this};
+					--it_;
+					return old;
+				}
+
+				Iterator& operator+=(difference_type n)
+				{
+					it_ += n;
+					return *this;
+				}
+
+				Iterator& operator-=(difference_type n)
+				{
+					it_ -= n;
+					return *this;
+				}
+
+				friend Iterator operator+(Iterator a, difference_type n)
+				{
+					return a += n;
+				}
+
+				friend Iterator operator+(difference_type n, Iterator a)
+				{
+					return a += n;
+				}
+
+				friend Iterator operator-(Iterator a, difference_type n)
+				{
+					return a -= n;
+				}
+
+				friend difference_type operator-(const Iterator& a, const Iterator& b)
+				{
+					return a.it_ - b.it_;
+				}
+
+				friend bool operator==(const Iterator& a, const Iterator& b)
+				{
+					return a.it_ == b.it_;
+				}
+
+				friend bool operator!=(const Iterator& a, const Iterator& b)
+				{
+					return a.it_ != b.it_;
+				}
+
+				friend bool operator<(const Iterator& a, const Iterator& b)
+				{
+					return a.it_ < b.it_;
+				}
+
+				friend bool operator>(const Iterator& a, const Iterator& b)
+				{
+					return a.it_ > b.it_;
+				}
+
+				friend bool operator<=(const Iterator& a, const Iterator& b)
+				{
+					return a.it_ <= b.it_;
+				}
+
+				friend bool operator>=(const Iterator& a, const Iterator& b)
+				{
+					return a.it_ >= b.it_;
+				}
+
+			private:
+
+				const char* data_{nullptr};
+				const Lookup* it_{nullptr};
+				const Value* tapeBegin_{nullptr};
+				const Value* tapeEnd_{nullptr};
+				std::size_t offset_{0};
+
+				Iterator(const SubtreeView& view, const Lookup* it) :
+					data_{view.data_},
+					it_{it},
+					tapeBegin_{view.tapeBegin_},
+					tapeEnd_{view.tapeEnd_},
+					offset_{view.offset_}
+				{}
+		};
+
+		// Constructs an inactive subtree without items.
+		SubtreeView() = default;
+
+		// Checks if the subtree was retrieved from a valid
+		// document with a non-empty prefix.
+		explicit operator bool() const
+		{
+			return isActive_;
+		}
+
+		// Counts the items, with constant complexity.
+		std::size_t size() const
+		{
+			return static_cast<std::size_t>(end_ - begin_);
+		}
+
+		// Retrieves an item by its key relative to the prefix.
+		// If the key does not exist, an inactive item is returned.
+		ItemView operator[](std::string_view key) const
+		{
+			return find(key);
+		}
+
+		// Iterates over the items in lexicographic order, without
+		// copying. The iterators remain valid as long as the document.
+		Iterator begin() const
+		{
+			return {*this, begin_};
+		}
+
+		Iterator end() const
+		{
+			return {*this, end_};
+		}
+
+		// Retrieves the items whose keys relative to the prefix are
+		// lexicographically greater than or equal to lo, and less than hi.
+		Range<Iterator> range(std::string_view lo, std::string_view hi) const
+		{
+			const SuffixLess less{data_, offset_};
+			const Lookup* const begin{std::lower_bound(begin_, end_, lo, less)};
+			const Lookup* const end{hi <= lo ? begin : std::lower_bound(begin, end_, hi, less)};
+			return {{*this, begin}, {*this, end}};
+		}
+
+		// Retrieves a nested subtree. The given prefix is relative
+		// to the prefix of this subtree.
+		SubtreeView subtree(std::string_view prefix) const
+		{
+			if (!isActive_ || prefix.empty())
+				return {};
+
+			// All keys which continue with prefix + '.' are sorted
+			// between prefix + '.' and prefix + '/'
+			const SuffixLess less{data_, offset_};
+
+			SubtreeView view{*this};
+			view.begin_ = std::lower_bound(begin_, end_, Bound{prefix, '.'}, less);
+			view.end_ = std::lower_bound(view.begin_, end_, Bound{prefix, '/'}, less);
+			view.offset_ = offset_ + prefix.size() + 1;
+			return view;
+		}
+
+	private:
+
+		struct Bound
+		{
+			std::string_view prefix;
+			char next;
+		};
+
+		struct SuffixLess
+		{
+			const char* data;
+			std::size_t offset;
+
+			bool operator()(const Lookup& a, const std::string_view& b) const
+			{
+				return a.keyView(data).substr(offset) < b;
+			}
+
+			// Compares with prefix + next, without concatenation
+			bool operator()(const Lookup& a, const Bound& b) const
+			{
+				const std::string_view key{a.keyView(data).substr(offset)};
+				const int cmp{key.substr(0, b.prefix.size()).compare(b.prefix)};
+
+				if (cmp != 0)
+					return cmp < 0;
+
+				return key.size() == b.prefix.size() || key[b.prefix.size()] < b.next;
+			}
+		};
+
+		const char* data_{nullptr};
+		const Lookup* begin_{nullptr};
+		const Lookup* end_{nullptr};
+
+		// An empty tape means that values are tokenized on demand
+		const Value* tapeBegin_{nullptr};
+		const Value* tapeEnd_{nullptr};
+
+		std::size_t offset_{0};
+		bool isActive_{false};
+
+		SubtreeView(const char* data, const Lookup* begin, const Lookup* end,
+			const Value* tapeBegin, const Value* tapeEnd) :
+			data_{data},
+			begin_{begin},
+			end_{end},
+			tapeBegin_{tapeBegin},
+			tapeEnd_{tapeEnd},
+			isActive_{true}
+		{}
+
+		ItemView find(std::string_view key) const
+		{
+			if (!isActive_)
+				return {};
+
+			const SuffixLess less{data_, offset_};
+			auto it{std::lower_bound(begin_, end_, key, less)};
+
+			const bool isFound{it != end_ && it->keyView(data_).substr(offset_) == key};
+			KCV_STATS(countLookup(isFound);)
+
+			if (isFound)
+				return makeItem(*it);
+
+			return {};
+		}
+
+		ItemView makeItem(const Lookup& lookup) const
+		{
+			return ItemView::make(data_, lookup, tapeBegin_, tapeEnd_);
+		}
+};
+
+
+class SourceIterator
+{
+	// Iterates over the items of a DocumentView in the order of
+	// the data, without sorting. Yields each key together with an
+	// ItemView. Tokenizes the data again while advancing. The pair
+	// is returned by value, so it is an input iterator.
+
+	template<std::size_t, std::size_t>
+	friend class DocumentView;
+
+	public:
+
+		using iterator_category = std::input_iterator_tag;
+		using value_type = std::pair<std::string_view, ItemView>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = value_type;
+
+		SourceIterator() = default;
+
+		value_type operator*() const
+		{
+			const Lookup lookup{keyPos_, keySize_, endPos_ - keyPos_};
+			return {lookup.keyView(data_), ItemView::make(data_, lookup, tapeBegin_, tapeEnd_)};
+		}
+
+		SourceIterator& operator++()
+		{
+			advance();
+			return *this;
+		}
+
+		SourceIterator operator++(int)
+		{
+			SourceIterator old{*this};
+			advance();
+			return old;
+		}
+
+		friend bool operator==(const SourceIterator& a, const SourceIterator& b)
+		{
+			return a.keyPos_ == b.keyPos_ && a.keySize_ == b.keySize_;
+		}
+
+		friend bool operator!=(const SourceIterator& a, const SourceIterator& b)
+		{
+			return !(a == b);
+		}
+
+	private:
+
+		const char* data_{nullptr};
+		const Value* tapeBegin_{nullptr};
+		const Value* tapeEnd_{nullptr};
+		Tokenizer tokenizer_{};
+
+		// The current item, which ends at the next key.
+		// A key size of zero marks the end.
+		std::size_t keyPos_{0};
+		std::size_t keySize_{0};
+		std::size_t endPos_{0};
+		std::size_t nextSize_{0};
+
+		SourceIterator(std::string_view data, const Value* tapeBegin, const Value* tapeEnd) :
+			data_{data.data()},
+			tapeBegin_{tapeBegin},
+			tapeEnd_{tapeEnd},
+			tokenizer_{Stream{data}, true}
+		{
+			// The data has already been validated,
+			// so it begins with a key or ends
+			const Token token{tokenizer_.get()};
+			endPos_ = token.pos();
+			nextSize_ = token.isKey() ? token.size() : 0;
+			advance();
+		}
+
+		void advance()
+		{
+			keyPos_ = endPos_;
+			keySize_ = nextSize_;
+
+			if (keySize_ == 0)
+			{
+				keyPos_ = 0;
+				return;
+			}
+
+			while (true)
+			{
+				const Token token{tokenizer_.get()};
+
+				if (!token.isValue())
+				{
+					endPos_ = token.pos();
+					nextSize_ = token.isKey() ? token.size() : 0;
+					return;
+				}
+			}
+		}
+};
+
+
+template<std::size_t MaxItemCount, std::size_t MaxValueCount = 0>
+class DocumentView
+{
+	// A read-only class which does not own or allocate data.
+	// Remains valid as long as the provided data string_view.
+	// Stores MaxItemCount*64 bits of metadata on the stack.
+	// If MaxValueCount is non-zero, another MaxValueCount*64
+	// bits store the position and type of each value, so that
+	// the values need not be tokenized again when read. This
+	// tape is a member like the lookups, not external storage,
+	// so its item views are bound to this DocumentView object.
+	// The data string size is limited to 4 GiB, the item
+	// size to 16 MiB, and the key size to 255 bytes.
+	// Item lookup has logarithmic complexity.
+
+	friend Overlay;
+	friend ItemCursor;
+
+	public:
+
+		// Constructs an empty document.
+		constexpr DocumentView() :
+			isOk_{true}
+		{}
+
+		// Parses a KCV string. If the parsing fails, or MaxItemCount
+		// or a non-zero MaxValueCount is exceeded, the document
+		// is considered empty. Can be evaluated at compile time,
+		// for example to validate an embedded string literal.
+		constexpr explicit DocumentView(std::string_view data)
+		{
+			parse(data, {});
+		}
+
+		// Parses a KCV string. If the parsing fails, or any of the
+		// limits, MaxItemCount or a non-zero MaxValueCount is exceeded,
+		// the document is considered empty. The parsing stops at the
+		// first exceeded limit. The memory limit does not apply.
+		constexpr DocumentView(std::string_view data, const ParseLimits& limits)
+		{
+			parse(data, limits);
+		}
+
+		// Checks if the constructor accepted the data string.
+		constexpr explicit operator bool() const
+		{
+			return isOk_;
+		}
+
+		// Retrieves an item. If the key does not exist,
+		// an inactive item is returned.
+		ItemView operator[](std::string_view key) const
+		{
+			return find(key);
+		}
+
+		// Same as operator[]. A lookup never alters the document,
+		// so concurrent calls are safe, as long as no thread calls
+		// reparse() or assigns the document.
+		ItemView find(std::string_view key) const
+		{
+			return root().find(key);
+		}
+
+		// Replaces the data string with an edited version of it,
+		// such as a file after a small change. Only the items around
+		// the change are tokenized again, and the index of the other
+		// items is reused. The result is the same as constructing
+		// a new document from the data with the original limits,
+		// also on failure.
+		bool reparse(std::string_view data)
+		{
+			if (!isOk_ || data_.data() == nullptr || !reparseEdit(data))
+				parse(data, limits_);
+
+			return isOk_;
+		}
+
+		// Retrieves the items whose keys begin with the given
+		// prefix and a dot, without copying. If the document
+		// is invalid or the prefix is empty, an inactive subtree
+		// is returned.
+		SubtreeView subtree(std::string_view prefix) const
+		{
+			return root().subtree(prefix);
+		}
+
+		// Iterates over the items in lexicographic order, without
+		// copying. The iterators remain valid as long as the document.
+		SubtreeView::Iterator begin() const
+		{
+			return root().begin();
+		}
+
+		SubtreeView::Iterator end() const
+		{
+			return root().end();
+		}
+
+		// Retrieves the items whose keys are lexicographically
+		// greater than or equal to lo, and less than hi.
+		Range<SubtreeView::Iterator> range(std::string_view lo, std::string_view hi) const
+		{
+			return root().range(lo, hi);
+		}
+
+		// Measures the size of the dump, which is written by dumpTo().
+		std::size_t dumpSize() const
+		{
+			if (!isOk_ || data_.data() == nullptr)
+				return 0;
+
+			std::size_t size{0};
+			for (std::size_t i{0}; i < lookupCount_; ++i)
+				size += detail::dumpSize(
+					lookups_[i].keyView(data_.data()),
+					lookups_[i].valView(data_.data()));
+			return size;
+		}
+
+		// Writes the items to a caller-provided buffer, in the same
+		// format as Document::dump(), without allocation. The items
+		// are ordered lexicographically. Returns the size of the dump.
+		// If it exceeds the capacity, nothing is written.
+		std::size_t dumpTo(char* data, std::size_t capacity) const
+		{
+			// An invalid document has an empty dump
+			const std::size_t size{dumpSize()};
+			if (size == 0 || size > capacity)
+				return size;
+
+			for (std::size_t i{0}; i < lookupCount_; ++i)
+				data = dumpItem(data,
+					lookups_[i].keyView(data_.data()),
+					lookups_[i].valView(data_.data()));
+			return size;
+		}
+
+		// Iterates over the items in the order of the data, which
+		// is tokenized again. Has linear complexity in total.
+		Range<SourceIterator> sourceOrder() const
+		{
+			if (!isOk_ || data_.data() == nullptr)
+				return {{}, {}};
+
+			const SubtreeView view{root()};
+			return {{data_, view.tapeBegin_, view.tapeEnd_}, {}};
+		}
+
+	private:
+
+		std::string_view data_{};
+
+		std::array<Lookup, MaxItemCount> lookups_{};
+		std::size_t lookupCount_{0};
+
+		std::array<Value, MaxValueCount> values_{};
+		std::size_t valueCount_{0};
+
+		ParseLimits limits_{};
 		bool isOk_{false};
+
+		// Parses a KCV string, discarding the previous items.
+		constexpr void parse(std::string_view data, const ParseLimits& limits)
+		{
+			data_ = {};
+			lookupCount_ = 0;
+			valueCount_ = 0;
+			limits_ = limits;
+			isOk_ = false;
+
+			Limiter limiter{limits};
+			if (!limiter.acceptData(data))
+				return;
+
+			Tokenizer tokenizer{Stream{data}, true};
+			tokenizer.limit(limits.maxItemSize);
+			std::size_t keyPos{0};
+			std::size_t keySize{0};
+
+			while (true)
+			{
+				const Token token{tokenizer.get()};
+
+				if (token.isKey() || token.isEof())
+				{
+					if (keySize != 0)
+					{
+						Lookup lookup{keyPos, keySize, token.pos() - keyPos};
+
+						if (!lookup || lookupCount_ == lookups_.size())
+							return;
+
+						lookups_[lookupCount_++] = lookup;
+					}
+
+					if (token.isEof())
+						break;
+
+					if (!limiter.acceptKey(token, lookupCount_))
+						return;
+
+					keyPos = token.pos();
+					keySize = token.size();
+				}
+				else if (!token.isValue())
+					return;
+				else if (keySize == 0)
+					return;
+				else if (!limiter.acceptValue(token))
+					return;
+				else if constexpr (MaxValueCount > 0)
+				{
+					Value value{token};
+
+					if (!value || valueCount_ == values_.size())
+						return;
+
+					values_[valueCount_++] = value;
+				}
+			}
+
+			KCV_STATS(StatsTimer timer{threadStats().sortNanoseconds};)
+
+			// Sort items and reject duplicate keys
+			if (!sortLookups(lookups_.data(), lookups_.data() + lookupCount_, data.data()))
+				return;
+
+			data_ = data;
+			isOk_ = true;
+		}
+
+		// Applies an edit by tokenizing only the changed items.
+		// Returns false if the edit cannot be applied, in which
+		// case the state is unspecified.
+		bool reparseEdit(std::string_view data)
+		{
+			Limiter limiter{limits_};
+			if (!limiter.acceptData(data))
+				return false;
+
+			const std::string_view old{data_};
+			Edit edit{old, data};
+
+			if (edit.isEqual(old, data))
+			{
+				data_ = data;
+				return true;
+			}
+
+			// The changed items begin at the last key before the change
+			std::size_t keyPos{0};
+			bool hasKey{false};
+
+			for (std::size_t i{0}; i < lookupCount_; ++i)
+			{
+				const std::size_t pos{lookups_[i].keyPos()};
+				if (pos < edit.prefixSize && (!hasKey || pos > keyPos))
+				{
+					keyPos = pos;
+					hasKey = true;
+				}
+			}
+
+			if (!hasKey || !edit.find(old, data, keyPos))
+				return false;
+
+			// Count the new items and values, and check their limits.
+			// The item count is checked once the old items are removed.
+			std::size_t newItemCount{0};
+			std::size_t newValueCount{0};
+			Tokenizer tokenizer{Stream{data.data(), data.size(), edit.begin}};
+			tokenizer.limit(limits_.maxItemSize);
+
+			for (Token token{tokenizer.get()}; token.pos() < edit.newEnd; token = tokenizer.get())
+			{
+				if (token.isKey())
+				{
+					if (!limiter.acceptKey(token, 0))
+						return false;
+					++newItemCount;
+				}
+				else if (!token.isValue() || !limiter.acceptValue(token))
+					return false;
+				else
+					++newValueCount;
+			}
+
+			// Remove the old items, and shift the later ones
+			std::size_t keptCount{0};
+
+			for (std::size_t i{0}; i < lookupCount_; ++i)
+			{
+				Lookup lookup{lookups_[i]};
+				const std::size_t pos{lookup.keyPos()};
+
+				if (pos >= edit.begin && pos < edit.oldEnd)
+					continue;
+
+				if (pos >= edit.oldEnd)
+				{
+					lookup = Lookup{edit.shift(pos), lookup.keySize(), lookup.itemSize()};
+					if (!lookup)
+						return false;
+				}
+
+				lookups_[keptCount++] = lookup;
+			}
+
+			if (newItemCount > lookups_.size() - keptCount)
+				return false;
+			if (limits_.maxItemCount != 0 && keptCount + newItemCount > limits_.maxItemCount)
+				return false;
+
+			Value* next{nullptr};
+
+			if constexpr (MaxValueCount > 0)
+			{
+				// Make room for the new values on the tape
+				Value* const begin{values_.data()};
+				Value* const end{values_.data() + valueCount_};
+				const Value::Less less{};
+
+				Value* const first{std::lower_bound(begin, end, edit.begin, less)};
+				Value* const last{std::lower_bound(first, end, edit.oldEnd, less)};
+				const std::size_t tailCount{static_cast<std::size_t>(end - last)};
+				const std::size_t headCount{static_cast<std::size_t>(first - begin)};
+
+				if (newValueCount > values_.size() - headCount - tailCount)
+					return false;
+
+				Value* const target{first + newValueCount};
+
+				if (target <= last)
+					for (std::size_t i{0}; i < tailCount; ++i)
+						target[i] = last[i].moved(edit.shift(last[i].pos()));
+				else
+					for (std::size_t i{tailCount}; i > 0; --i)
+						target[i - 1] = last[i - 1].moved(edit.shift(last[i - 1].pos()));
+
+				for (std::size_t i{0}; i < tailCount; ++i)
+					if (!target[i])
+						return false;
+
+				valueCount_ = headCount + newValueCount + tailCount;
+				next = first;
+			}
+
+			// Tokenize the new items
+			Lookup* const added{lookups_.data() + keptCount};
+			std::size_t addedCount{0};
+			std::size_t keySize{0};
+			tokenizer = Tokenizer{Stream{data.data(), data.size(), edit.begin}};
+
+			while (true)
+			{
+				const Token token{tokenizer.get()};
+				const bool isEnd{token.pos() >= edit.newEnd};
+
+				if (token.isKey() || isEnd)
+				{
+					if (keySize != 0)
+					{
+						added[addedCount] = Lookup{keyPos, keySize, token.pos() - keyPos};
+						if (!added[addedCount++])
+							return false;
+					}
+
+					if (isEnd)
+						break;
+
+					keyPos = token.pos();
+					keySize = token.size();
+				}
+				else if (next != nullptr)
+				{
+					*next = Value{token};
+					if (!*next++)
+						return false;
+				}
+			}
+
+			// Sort the new items into the index
+			data_ = data;
+
+			if (!sortLookups(added, added + addedCount, data.data()))
+				return false;
+			if (!mergeLookups(lookups_.data(), added, added + addedCount, data.data()))
+				return false;
+
+			lookupCount_ = keptCount + addedCount;
+			isOk_ = true;
+			return true;
+		}
+
+		ItemView makeItem(const Lookup& lookup) const
+		{
+			return root().makeItem(lookup);
+		}
+
+		SubtreeView root() const
+		{
+			if (!isOk_ || data_.data() == nullptr)
+				return {};
+
+			const Value* tape{nullptr};
+			if constexpr (MaxValueCount > 0)
+				tape = values_.data();
+
+			return {data_.data(), lookups_.data(), lookups_.data() + lookupCount_,
+				tape, tape == nullptr ? nullptr : tape + valueCount_};
+		}
+};
+
+
+
+class Overlay
+{
+	// Combines several documents into layers, without copying
+	// their data. Lookups are answered by the layer with the highest
+	// priority which contains the key. Remains valid as long as
+	// the layers are valid and unchanged.
+
+	public:
+
+		// Constructs an overlay without layers.
+		Overlay() = default;
+
+		// Adds a Document or DocumentView, with a higher
+		// priority than all previously added layers.
+		// Discards the merged index.
+		template<typename D>
+		void push(const D& layer)
+		{
+			layers_.push_back({&layer, &collectLayer<D>, &findLayer<D>, &itemLayer<D>});
+			index_.clear();
+			isIndexed_ = false;
+		}
+
+		// Layers are referenced, so temporaries are rejected.
+		template<typename D>
+		void push(const D&&) = delete;
+
+		// Merges the sorted keys of all layers into a single index,
+		// so that a lookup needs only one binary search instead of
+		// one per layer. Must be repeated after a layer has changed.
+		// Has O(n log k) complexity for n keys in k layers.
+		void index()
+		{
+			// Collect the sorted run of each layer
+			std::vector<Entry> entries{};
+			std::vector<Cursor> cursors{};
+
+			for (std::size_t i{0}; i < layers_.size(); ++i)
+			{
+				const std::size_t begin{entries.size()};
+				layers_[i].collect(layers_[i].document, i, entries);
+
+				if (entries.size() > begin)
+					cursors.push_back({begin, entries.size()});
+			}
+
+			// k-way merge with a heap of cursors. Equal keys are
+			// popped in descending layer order, so the first one
+			// is kept and the entries of lower layers are skipped.
+			const CursorGreater greater{entries.data()};
+			std::make_heap(cursors.begin(), cursors.end(), greater);
+
+			index_.clear();
+			index_.reserve(entries.size());
+
+			while (!cursors.empty())
+			{
+				std::pop_heap(cursors.begin(), cursors.end(), greater);
+				Cursor& cursor{cursors.back()};
+				const Entry& entry{entries[cursor.pos]};
+
+				if (index_.empty() || index_.back().key != entry.key)
+					index_.push_back(entry);
+
+				if (++cursor.pos < cursor.end)
+					std::push_heap(cursors.begin(), cursors.end(), greater);
+				else
+					cursors.pop_back();
+			}
+
+			isIndexed_ = true;
+		}
+
+		// Retrieves an item from the layer with the highest priority
+		// which contains the key. If no layer contains the key,
+		// an inactive item is returned.
+		ItemView operator[](std::string_view key) const
+		{
+			if (isIndexed_)
+			{
+				auto it{std::lower_bound(index_.begin(), index_.end(), key, EntryLess{})};
+				if (it != index_.end() && it->key == key)
+				{
+					const Layer& layer{layers_[it->layer]};
+					return layer.item(layer.document, it->ref);
+				}
+				return {};
+			}
+
+			for (auto it{layers_.rbegin()}; it != layers_.rend(); ++it)
+			{
+				ItemView item{it->find(it->document, key)};
+				if (item)
+					return item;
+			}
+
+			return {};
+		}
+
+	private:
+
+		struct Entry
+		{
+			std::string_view key;
+			const void* ref;
+			std::size_t layer;
+		};
+
+		struct EntryLess
+		{
+			bool operator()(const Entry& a, const std::string_view& b) const
+			{
+				return a.key < b;
+			}
+		};
+
+		struct Cursor
+		{
+			std::size_t pos;
+			std::size_t end;
+		};
+
+		struct CursorGreater
+		{
+			const Entry* entries;
+
+			bool operator()(const Cursor& a, const Cursor& b) const
+			{
+				// Orders the heap by ascending key
+				// and then by descending layer
+				const Entry& x{entries[a.pos]};
+				const Entry& y{entries[b.pos]};
+				return x.key > y.key || (x.key == y.key && x.layer < y.layer);
+			}
+		};
+
+		struct Layer
+		{
+			const void* document;
+			void (*collect)(const void*, std::size_t, std::vector<Entry>&);
+			ItemView (*find)(const void*, std::string_view);
+			ItemView (*item)(const void*, const void*);
+		};
+
+		std::vector<Layer> layers_{};
+		std::vector<Entry> index_{};
+		bool isIndexed_{false};
+
+		static void collect(const Document& doc, std::size_t layer, std::vector<Entry>& out)
+		{
+			for (const auto& [key, values] : doc.items_)
+				out.push_back({key, &(values.text), layer});
+		}
+
+		template<std::size_t N, std::size_t M>
+		static void collect(const DocumentView<N, M>& doc, std::size_t layer, std::vector<Entry>& out)
+		{
+			if (!doc.isOk_ || doc.data_.data() == nullptr)
+				return;
+
+			for (std::size_t i{0}; i < doc.lookupCount_; ++i)
+				out.push_back({doc.lookups_[i].keyView(doc.data_.data()), &doc.lookups_[i], layer});
+		}
+
+		static ItemView item(const Document&, const void* ref)
+		{
+			return ItemView{std::string_view{*static_cast<const std::string*>(ref)}};
+		}
+
+		template<std::size_t N, std::size_t M>
+		static ItemView item(const DocumentView<N, M>& doc, const void* ref)
+		{
+			return doc.makeItem(*static_cast<const Lookup*>(ref));
+		}
+
+		template<typename D>
+		static void collectLayer(const void* doc, std::size_t layer, std::vector<Entry>& out)
+		{
+			collect(*static_cast<const D*>(doc), layer, out);
+		}
+
+		template<typename D>
+		static ItemView findLayer(const void* doc, std::string_view key)
+		{
+			return static_cast<const D*>(doc)->find(key);
+		}
+
+		template<typename D>
+		static ItemView itemLayer(const void* doc, const void* ref)
+		{
+			return item(*static_cast<const D*>(doc), ref);
+		}
 };
 
 
-template<std::size_t>
-class DocumentView;
-class ItemView
+// Schema binding
+// --------------
+
+template<typename S, typename T>
+struct Field
 {
-	template<std::size_t>
-	friend class DocumentView;
+	std::string_view key;
+	T S::* member;
+};
+
+template<typename... F>
+struct Schema
+{
+	std::tuple<F...> fields;
+};
+
+struct BindOptions
+{
+	bool rejectUnknownKeys{false};
+	bool rejectMissingKeys{false};
+};
+
+// Describes an item which is bound to a member variable.
+template<typename S, typename T>
+constexpr Field<S, T> field(std::string_view key, T S::* member)
+{
+	return {key, member};
+}
+
+// Describes the items which are bound to a struct.
+template<typename... F>
+constexpr Schema<F...> schema(F... fields)
+{
+	return {std::tuple<F...>{fields...}};
+}
+
+template<typename... F, std::size_t... I>
+std::size_t findField(const Schema<F...>& schema, std::string_view key, std::index_sequence<I...>)
+{
+	std::size_t index{sizeof...(F)};
+	((std::get<I>(schema.fields).key == key && (index = I, true)) || ...);
+	return index;
+}
+
+template<typename S, typename... F, std::size_t... I>
+bool readField(S& target, const Schema<F...>& schema, std::size_t index, const Token& token, std::index_sequence<I...>)
+{
+	bool isOk{false};
+	((index == I && (isOk = token.read(target.*(std::get<I>(schema.fields).member)), true)) || ...);
+	return isOk;
+}
+
+// Parses a KCV string and assigns each item with exactly one
+// value directly to the corresponding member of the target,
+// without constructing a document. Returns false if the parsing
+// fails, an item of the schema does not have exactly one value
+// of the member type, or a key violates the options. The target
+// may be partially assigned on failure. Duplicate keys which are
+// not part of the schema are not detected.
+template<typename S, typename... F>
+bool bind(std::string_view data, S& target, const Schema<F...>& schema, const BindOptions& options = {})
+{
+	constexpr std::size_t fieldCount{sizeof...(F)};
+	constexpr auto indices{std::index_sequence_for<F...>{}};
+
+	std::array<bool, fieldCount> isFound{};
+	std::size_t index{fieldCount};
+	std::size_t valueCount{0};
+	bool hasKey{false};
+
+	Tokenizer tokenizer{Stream{data}, true};
+
+	while (true)
+	{
+		const Token token{tokenizer.get()};
+
+		if (token.isKey() || token.isEof())
+		{
+			if (index < fieldCount && valueCount != 1)
+				return false;
+
+			if (token.isEof())
+				break;
+
+			index = findField(schema, token.text(), indices);
+			valueCount = 0;
+			hasKey = true;
+
+			if (index < fieldCount)
+			{
+				if (isFound[index])
+					return false;
+				isFound[index] = true;
+			}
+			else if (options.rejectUnknownKeys)
+				return false;
+		}
+		else if (!token.isValue())
+			return false;
+		else if (!hasKey)
+			return false;
+		else if (index < fieldCount)
+		{
+			if (valueCount++ == 0 && !readField(target, schema, index, token, indices))
+				return false;
+		}
+	}
+
+	if (options.rejectMissingKeys)
+		for (bool found : isFound)
+			if (!found)
+				return false;
+
+	return true;
+}
+
+
+// Diff
+// ----
+
+// A difference between two documents. The values are copied
+// from the second document, and are empty if the item was removed.
+struct Change
+{
+	enum class Type
+	{
+		added,
+		removed,
+		changed
+	};
+
+	Type type;
+	std::string key;
+	std::string values;
+};
+
+class ItemCursor
+{
+	// Walks over the raw items of a Document or DocumentView
+	// in lexicographic order, without copying.
 
 	public:
 
-		// Checks if the item is active after construction,
-		// or if the most recent read or write was successul.
-		explicit operator bool() const
+		explicit ItemCursor(const Document& doc) :
+			it_{doc.items_.begin()},
+			end_{doc.items_.end()}
 		{
-			return isOk_;
+			load();
 		}
 
-		// Reads the next value and assigns it to a standard bool,
-		// integral, floating-point, string, or string_view variable.
-		// If the read fails, the target variable is left unchanged.
-		// A string_view cannot contain any escape sequence.
-		template<typename T>
-		ItemView& operator>>(T& target)
+		template<std::size_t N, std::size_t M>
+		explicit ItemCursor(const DocumentView<N, M>& doc)
 		{
-			isOk_ = isOk_ && tokenizer_.get().read(target);
-			return *this;
+			if (!doc.isOk_ || doc.data_.data() == nullptr)
+				return;
+
+			data_ = doc.data_.data();
+			lookup_ = doc.lookups_.data();
+			lookupEnd_ = lookup_ + doc.lookupCount_;
+			load();
+		}
+
+		bool isEnd() const
+		{
+			return isEnd_;
+		}
+
+		std::string_view key() const
+		{
+			return key_;
+		}
+
+		std::string_view values() const
+		{
+			return values_;
+		}
+
+		void next()
+		{
+			if (data_ != nullptr)
+				++lookup_;
+			else
+				++it_;
+			load();
 		}
 
 	private:
 
-		Tokenizer tokenizer_{};
-		bool isOk_{false};
+		Document::Map::const_iterator it_{};
+		Document::Map::const_iterator end_{};
 
-		ItemView() = default;
+		const char* data_{nullptr};
+		const Lookup* lookup_{nullptr};
+		const Lookup* lookupEnd_{nullptr};
 
-		explicit ItemView(Tokenizer tokenizer) :
-			tokenizer_{tokenizer},
-			isOk_{true}
-		{}
+		std::string_view key_{};
+		std::string_view values_{};
+		bool isEnd_{true};
+
+		void load()
+		{
+			if (data_ != nullptr)
+			{
+				isEnd_ = (lookup_ == lookupEnd_);
+				if (!isEnd_)
+				{
+					key_ = lookup_->keyView(data_);
+					values_ = lookup_->valView(data_);
+				}
+			}
+			else
+			{
+				isEnd_ = (it_ == end_);
+				if (!isEnd_)
+				{
+					key_ = it_->first;
+					values_ = it_->second.text;
+				}
+			}
+		}
 };
 
+// Removes the whitespace around values.
+inline std::string_view trimValues(std::string_view values)
+{
+	std::size_t begin{0};
+	while (begin < values.size() && isWs(values[begin]))
+		++begin;
+
+	std::size_t end{values.size()};
+	while (end > begin && isWs(values[end - 1]))
+		--end;
 
-template<std::size_t MaxItemCount>
-class DocumentView
+	return values.substr(begin, end - begin);
+}
+
+// Compares two documents, which may be a Document or a DocumentView,
+// by walking their sorted items in a single pass. Returns the changes
+// which turn the first document into the second, ordered by key. The
+// values are compared bytewise, ignoring the whitespace around them.
+// An invalid DocumentView is considered empty.
+template<typename A, typename B>
+Patch diff(const A& a, const B& b)
 {
-	// A read-only class which does not own or allocate data.
-	// Remains valid as long as the provided data string_view.
-	// Stores MaxItemCount*64 bits of metadata on the stack.
-	// The data string size is limited to 4 GiB, the item
-	// size to 16 MiB, and the key size to 255 bytes.
-	// Item lookup has logarithmic complexity.
+	Patch patch{};
+	ItemCursor from{a};
+	ItemCursor to{b};
 
-	public:
+	while (!from.isEnd() || !to.isEnd())
+	{
+		const int order{from.isEnd() ? 1 : to.isEnd() ? -1 : from.key().compare(to.key())};
 
-		// Constructs an empty document.
-		DocumentView() :
-			isOk_{true}
-		{}
+		if (order < 0)
+		{
+			patch.push_back({Change::Type::removed, std::string{from.key()}, {}});
+			from.next();
+		}
+		else if (order > 0)
+		{
+			patch.push_back({Change::Type::added, std::string{to.key()}, std::string{to.values()}});
+			to.next();
+		}
+		else
+		{
+			if (trimValues(from.values()) != trimValues(to.values()))
+				patch.push_back({Change::Type::changed, std::string{to.key()}, std::string{to.values()}});
+			from.next();
+			to.next();
+		}
+	}
 
-		// Parses a KCV string. If the parsing fails, or MaxItemCount
-		// is exceeded, the document is considered empty.
-		explicit DocumentView(std::string_view data)
+	return patch;
+}
+
+// Applies the changes of a patch to a document in place. Items
+// which are not part of the patch remain valid. Returns false if
+// the document does not match the first document of the diff, for
+// example if an added key exists already, or if a changed key is
+// missing. In that case, the changes are still applied where
+// possible, and invalid keys are skipped.
+inline bool apply(Document& doc, const Patch& patch)
+{
+	bool isOk{true};
+
+	for (const Change& change : patch)
+	{
+		if (!isKey(change.key))
 		{
-			Tokenizer tokenizer{Stream{data}, true};
-			std::size_t keyPos{0};
-			std::size_t keySize{0};
+			isOk = false;
+			continue;
+		}
 
-			while (true)
-			{
-				const Token token{tokenizer.get()};
+		auto found{doc.items_.find(change.key)};
+		const bool isFound{found != doc.items_.end()};
 
-				if (token.isKey() || token.isEof())
+		switch (change.type)
+		{
+			case Change::Type::removed:
+				if (isFound)
+					doc.items_.erase(found);
+				isOk = isOk && isFound;
+				break;
+
+			case Change::Type::added:
+			case Change::Type::changed:
+				if (isFound)
 				{
-					if (keySize != 0)
-					{
-						Lookup lookup{keyPos, keySize, token.pos() - keyPos};
+					found->second.text.assign(change.values);
+					found->second.cache.clear();
+				}
+				else
+					doc.items_.try_emplace(change.key, Values{change.values});
+				isOk = isOk && (isFound == (change.type == Change::Type::changed));
+				break;
+		}
+	}
 
-						if (!lookup || end_ == lookups_.end())
-							return;
+	return isOk;
+}
 
-						*end_++ = lookup;
-					}
 
-					if (token.isEof())
-						break;
+#ifdef KCV_ENABLE_LOADER
 
-					keyPos = token.pos();
-					keySize = token.size();
-				}
-				else if (!token.isValue())
-					return;
-				else if (keySize == 0)
-					return;
-			}
+// Batch loading
+// -------------
 
-			// Sort items
-			const Lookup::Less less{data.data()};
-			std::sort(lookups_.begin(), end_, less);
+struct LoadOptions
+{
+	std::size_t threadCount{0};  // Zero uses the hardware concurrency
+	std::size_t maxItemCount{0}; // Applied to each document
+};
 
-			// Reject duplicate keys
-			const Lookup::Equal equal{data.data()};
-			if (std::adjacent_find(lookups_.begin(), end_, equal) != end_)
-				return;
+struct LoadResult
+{
+	enum class Status {notLoaded, ok, readFailed, parseFailed, exception};
+
+	Document document{};               // Tests false unless the file was parsed
+	Status status{Status::notLoaded};
+	std::size_t errorPos{0};           // Where the parsing failed, if it did
+	std::exception_ptr exception{};    // What was thrown, if anything
+
+	// Checks if the file was read and parsed.
+	explicit operator bool() const
+	{
+		return status == Status::ok;
+	}
+};
 
-			data_ = data.data();
-			isOk_ = true;
+class Loader
+{
+	// Reads and parses files on a pool of worker threads.
+	// Each worker claims the next file, so that reading
+	// on one thread overlaps with parsing on the others.
+
+	public:
+
+		Loader(const std::vector<std::string>& paths, const LoadOptions& options) :
+			paths_{paths},
+			options_{options},
+			results_(paths.size())
+		{
+			// A document is only valid once its file is parsed
+			for (LoadResult& result : results_)
+				result.document.isOk_ = false;
 		}
 
-		// Checks if the constructor accepted the data string.
-		explicit operator bool() const
+		std::vector<LoadResult> run()
 		{
-			return isOk_;
+			std::size_t threadCount{options_.threadCount};
+			if (threadCount == 0)
+				threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+			threadCount = std::min(threadCount, paths_.size());
+
+			// The calling thread is one of the workers. If a thread
+			// cannot be started, the others claim its files instead.
+			std::vector<std::thread> threads{};
+			const Joiner joiner{threads};
+			threads.reserve(threadCount > 0 ? threadCount - 1 : 0);
+
+			for (std::size_t i{1}; i < threadCount; ++i)
+			{
+				try
+				{
+					threads.emplace_back(&Loader::work, this);
+				}
+				catch (const std::system_error&)
+				{
+					break;
+				}
+			}
+
+			work();
+			joiner.join();
+
+			return std::move(results_);
 		}
 
-		// Retrieves an item. If the key does not exist,
-		// an inactive item is returned.
-		ItemView operator[](std::string_view key)
+	private:
+
+		struct Joiner
 		{
-			if (isOk_ && data_ != nullptr)
+			// Joins the started threads, also when unwinding,
+			// because destroying a joinable thread terminates.
+
+			std::vector<std::thread>& threads;
+
+			~Joiner()
 			{
-				const Lookup::Less less{data_};
-				const Lookup::Equal equal{data_};
-				auto it{std::lower_bound(lookups_.begin(), end_, key, less)};
+				join();
+			}
 
-				if (it != end_ && equal(*it, key))
-					return ItemView{Tokenizer{Stream{it->valView(data_)}}};
+			void join() const
+			{
+				for (std::thread& thread : threads)
+					if (thread.joinable())
+						thread.join();
 			}
+		};
 
-			return {};
+		const std::vector<std::string>& paths_;
+		LoadOptions options_;
+		std::vector<LoadResult> results_;
+		std::atomic<std::size_t> next_{0};
+
+		void work()
+		{
+			// The buffer is reused for all files of this worker,
+			// because the document copies the keys and values
+			std::string data{};
+
+			while (true)
+			{
+				const std::size_t index{next_.fetch_add(1)};
+				if (index >= paths_.size())
+					break;
+
+				// An exception, such as bad_alloc, only fails
+				// this file, instead of escaping the thread
+				LoadResult& result{results_[index]};
+				try
+				{
+					load(paths_[index], data, result);
+				}
+				catch (...)
+				{
+					result.document = Document{};
+					result.document.isOk_ = false;
+					result.status = LoadResult::Status::exception;
+					result.exception = std::current_exception();
+				}
+			}
 		}
 
-	private:
+		void load(const std::string& path, std::string& data, LoadResult& result) const
+		{
+			if (!read(path, data))
+			{
+				result.status = LoadResult::Status::readFailed;
+				return;
+			}
 
-		using Array = std::array<Lookup, MaxItemCount>;
-		using ArrayIt = typename Array::iterator;
+			Document document{};
+			document.isOk_ = false;
 
-		const char* data_{nullptr};
+			ParseLimits limits{};
+			limits.maxItemCount = options_.maxItemCount;
+			const std::size_t errorPos{document.parse(data, limits)};
+			result.document = std::move(document);
 
-		Array lookups_{};
-		ArrayIt end_{lookups_.begin()};
+			if (errorPos != std::string_view::npos)
+			{
+				result.status = LoadResult::Status::parseFailed;
+				result.errorPos = errorPos;
+			}
+			else
+				result.status = LoadResult::Status::ok;
+		}
 
-		bool isOk_{false};
+		static bool read(const std::string& path, std::string& data)
+		{
+			std::ifstream file{path, std::ios::binary | std::ios::ate};
+			if (!file)
+				return false;
+
+			const auto size{file.tellg()};
+			if (size < 0)
+				return false;
+
+			data.resize(static_cast<std::size_t>(size));
+			file.seekg(0);
+			file.read(data.data(), static_cast<std::streamsize>(size));
+			return static_cast<bool>(file);
+		}
 };
 
+// Reads and parses many files in parallel. Returns one result
+// per path, in the same order. If a file cannot be read, or its
+// parsing fails, the document of its result is empty and the
+// status tells why. A failed parse also records the byte position
+// of the error. An exception thrown while loading a file is
+// caught and stored in its result.
+inline std::vector<LoadResult> loadAll(const std::vector<std::string>& paths, const LoadOptions& options = {})
+{
+	return Loader{paths, options}.run();
+}
+
+#endif // KCV_ENABLE_LOADER
+
 } // namespace detail
 
 
@@ -1331,8 +5378,39 @@ using detail::DocumentView;
 using detail::ItemView;
 
 using detail::Document;
+using detail::DocumentBuilder;
+using detail::Writer;
+using detail::KeyTable;
+using detail::InternedDocument;
 using detail::Item;
 
+using detail::Overlay;
+using detail::SubtreeView;
+using detail::Change;
+using detail::Patch;
+using detail::diff;
+using detail::apply;
+
+using detail::StringBuffer;
+using detail::Token;
+using detail::ParseLimits;
+
+using detail::Stats;
+using detail::stats;
+using detail::resetStats;
+using TokenType = detail::Token::Type;
+
+using detail::BindOptions;
+using detail::bind;
+using detail::field;
+using detail::schema;
+
+#ifdef KCV_ENABLE_LOADER
+using detail::LoadOptions;
+using detail::LoadResult;
+using detail::loadAll;
+#endif
+
 using detail::hex;
 using detail::fixed;
 using detail::general;
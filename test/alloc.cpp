@@ -0,0 +1,236 @@
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include "doctest/doctest.h"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+
+#include "kcv/kcv.hpp"
+
+
+// Allocation accounting
+// ---------------------
+
+namespace {
+
+std::size_t allocationCount{0};
+std::size_t allocationBytes{0};
+
+class Allocations
+{
+	// Counts the global allocations since construction.
+
+	public:
+
+		std::size_t count() const
+		{
+			return allocationCount - count_;
+		}
+
+		std::size_t bytes() const
+		{
+			return allocationBytes - bytes_;
+		}
+
+	private:
+
+		std::size_t count_{allocationCount};
+		std::size_t bytes_{allocationBytes};
+};
+
+std::string makeData(std::size_t itemCount)
+{
+	std::string data{};
+	for (std::size_t i{0}; i < itemCount; ++i)
+		data += "key" + std::to_string(i) + ": yes 42 -0.5 \"str\" \"\\t\"\n";
+	return data;
+}
+
+constexpr std::size_t itemCount{64};
+
+} // namespace
+
+
+void* operator new(std::size_t size)
+{
+	++allocationCount;
+	allocationBytes += size;
+
+	if (void* ptr{std::malloc(size > 0 ? size : 1)})
+		return ptr;
+
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+
+// Read-only
+// ---------
+
+TEST_CASE_TEMPLATE("DocumentView does not allocate", D,
+	kcv::DocumentView<itemCount>, kcv::DocumentView<itemCount, itemCount*5>)
+{
+	const std::string data{makeData(itemCount)};
+
+	bool b{};
+	int i{};
+	double f{};
+	std::string_view v{};
+
+	Allocations allocations{};
+
+	D doc{data};
+	const bool isOk{static_cast<bool>(doc)};
+
+	for (std::size_t n{0}; n < itemCount; ++n)
+	{
+		char key[16]{"key"};
+		auto result{std::to_chars(key + 3, key + sizeof(key), n)};
+		doc[std::string_view{key, static_cast<std::size_t>(result.ptr - key)}] >> b >> i >> f >> v;
+	}
+
+	std::size_t sortedCount{0};
+	for (auto entry : doc)
+		sortedCount += static_cast<bool>(entry.second);
+
+	std::size_t sourceCount{0};
+	for (auto entry : doc.sourceOrder())
+		sourceCount += static_cast<bool>(entry.second);
+
+	std::size_t tokenCount{0};
+	for (auto entry : doc)
+		for (const auto& token : entry.second.tokens())
+			tokenCount += token.isValue();
+
+	char dump[8192];
+	const std::size_t dumpSize{doc.dumpTo(dump, sizeof(dump))};
+
+	const std::size_t count{allocations.count()};
+
+	REQUIRE(isOk);
+	REQUIRE(count == 0);
+	REQUIRE(sortedCount == itemCount);
+	REQUIRE(sourceCount == itemCount);
+	REQUIRE(tokenCount == itemCount * 5);
+	REQUIRE(dumpSize == data.size());
+	REQUIRE(b == true);
+	REQUIRE(i == 42);
+	REQUIRE(f == -0.5);
+	REQUIRE(v == "str");
+}
+
+
+TEST_CASE("StringBuffer does not allocate")
+{
+	const std::string data{makeData(1)};
+	kcv::DocumentView<1> doc{data};
+
+	char chars[8]{};
+	kcv::StringBuffer literal{chars, sizeof(chars)};
+	kcv::StringBuffer escaped{chars, sizeof(chars)};
+
+	Allocations allocations{};
+	auto item{doc["key0"]};
+	item.at(3) >> literal >> escaped;
+	const std::size_t count{allocations.count()};
+
+	REQUIRE(item);
+	REQUIRE(escaped.size == 1);
+	REQUIRE(count == 0);
+}
+
+
+// Document
+// --------
+
+TEST_CASE("Document allocations per item")
+{
+	const std::string data{makeData(itemCount)};
+
+	SUBCASE("load")
+	{
+		Allocations allocations{};
+		kcv::Document doc{data};
+		const std::size_t count{allocations.count()};
+
+		REQUIRE(doc);
+		MESSAGE("load: ", count / itemCount, " allocations and ",
+			allocations.bytes() / itemCount, " bytes per item");
+
+		// One map node and one value string per item,
+		// the short keys fit into the small buffer
+		REQUIRE(count == itemCount * 2);
+	}
+	SUBCASE("write")
+	{
+		kcv::Document doc{data};
+		doc["key0"] << 0;
+
+		Allocations allocations{};
+		for (std::size_t n{0}; n < itemCount; ++n)
+			doc["key0"] << n;
+		const std::size_t count{allocations.count()};
+
+		MESSAGE("write: ", count, " allocations for ", itemCount, " values");
+
+		// Small values reuse the existing string
+		REQUIRE(count == 0);
+	}
+	SUBCASE("set")
+	{
+		kcv::Document doc{data};
+		doc["key0"].set(kcv::hex(0, 16));
+
+		Allocations allocations{};
+		for (std::size_t n{0}; n < itemCount; ++n)
+			doc["key0"].set(kcv::hex(n * 0x0123456789ABCDEFu, 16));
+		const std::size_t count{allocations.count()};
+
+		MESSAGE("set: ", count, " allocations for ", itemCount, " values");
+
+		// Fixed-width values are overwritten in place
+		REQUIRE(count == 0);
+	}
+	SUBCASE("insert")
+	{
+		kcv::Document doc{};
+
+		Allocations allocations{};
+		for (std::size_t n{0}; n < itemCount; ++n)
+		{
+			char key[16]{"key"};
+			auto result{std::to_chars(key + 3, key + sizeof(key), n)};
+			doc[std::string_view{key, static_cast<std::size_t>(result.ptr - key)}] << n;
+		}
+		const std::size_t count{allocations.count()};
+
+		MESSAGE("insert: ", count / itemCount, " allocations per item");
+		REQUIRE(count == itemCount);
+	}
+	SUBCASE("dump")
+	{
+		kcv::Document doc{data};
+
+		Allocations allocations{};
+		const std::string out{doc.dump()};
+		const std::size_t count{allocations.count()};
+
+		MESSAGE("dump: ", count, " allocations for ", itemCount, " items");
+
+		// The output is reserved up front
+		REQUIRE(count == 1);
+		REQUIRE(out.size() == data.size());
+	}
+}
@@ -0,0 +1,115 @@
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include "doctest/doctest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "kcv/kcv.hpp"
+
+
+// Measures the tokenizer on a mixed document. Only the internal
+// Tokenizer and Stream constructors and Token::isEof/isKey/isValue
+// are used, which are unchanged since 0.2.0, so that this file can
+// also be built against an older header for comparison. The results
+// are only meaningful in an optimized build.
+
+
+namespace {
+
+constexpr std::size_t itemCount{200000};
+constexpr std::size_t runCount{7};
+
+std::string makeData()
+{
+	// Keys, integers, floats, hex numbers, bools,
+	// and ASCII, escaped and UTF-8 strings
+	std::string data{};
+
+	for (std::size_t n{0}; n < itemCount; ++n)
+	{
+		const std::string i{std::to_string(n)};
+		data += "section.item" + i + ": " + i + " -" + i + " " + i + ".25e-3 0x" + i
+			+ (n % 2 ? " yes" : " no")
+			+ " \"plain ascii text " + i + "\""
+			+ " \"escaped \\\"quote\\\"\\n\\u00E4\""
+			+ " \"utf-8 \xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80\"\n";
+	}
+
+	return data;
+}
+
+struct Result
+{
+	std::size_t tokenCount{0};
+	bool isOk{true};
+};
+
+Result tokenize(std::string_view data)
+{
+	Result result{};
+	kcv::detail::Tokenizer tokenizer{kcv::detail::Stream{data}, true};
+
+	while (true)
+	{
+		const kcv::detail::Token token{tokenizer.get()};
+		if (token.isEof())
+			break;
+
+		result.isOk = result.isOk && (token.isKey() || token.isValue());
+		++result.tokenCount;
+	}
+
+	return result;
+}
+
+// Runs the function runCount times and returns
+// the fastest run in milliseconds.
+template<typename F>
+double fastest(F function)
+{
+	double best{0};
+
+	for (std::size_t run{0}; run < runCount; ++run)
+	{
+		const auto begin{std::chrono::steady_clock::now()};
+		function();
+		const auto end{std::chrono::steady_clock::now()};
+
+		const double ms{std::chrono::duration<double, std::milli>(end - begin).count()};
+		best = run == 0 ? ms : std::min(best, ms);
+	}
+
+	return best;
+}
+
+} // namespace
+
+
+TEST_CASE("tokenizer throughput")
+{
+	const std::string data{makeData()};
+	Result result{};
+
+	const double ms{fastest([&]() { result = tokenize(data); })};
+
+	REQUIRE(result.isOk);
+	REQUIRE(result.tokenCount == itemCount * 9);
+
+	const double mb{static_cast<double>(data.size()) / 1e6};
+	MESSAGE("tokenize ", mb, " MB: ", ms, " ms, ", mb / ms * 1e3, " MB/s");
+}
+
+
+TEST_CASE("Document construction time")
+{
+	const std::string data{makeData()};
+	bool isOk{false};
+
+	const double ms{fastest([&]() { isOk = static_cast<bool>(kcv::Document{data}); })};
+
+	REQUIRE(isOk);
+	MESSAGE("construct Document of ", itemCount, " items: ", ms, " ms");
+}
@@ -0,0 +1,153 @@
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include "doctest/doctest.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "kcv/kcv.hpp"
+
+
+class TempFiles
+{
+	// Creates files in a temporary directory,
+	// which is removed on destruction.
+
+	public:
+
+		TempFiles() :
+			dir_{std::filesystem::temp_directory_path() / "kcv-load-test"}
+		{
+			std::filesystem::remove_all(dir_);
+			std::filesystem::create_directory(dir_);
+		}
+
+		~TempFiles()
+		{
+			std::filesystem::remove_all(dir_);
+		}
+
+		std::string add(const std::string& name, const std::string& content)
+		{
+			const std::filesystem::path path{dir_ / name};
+			std::ofstream file{path, std::ios::binary};
+			file << content;
+			return path.string();
+		}
+
+		std::string missing(const std::string& name) const
+		{
+			return (dir_ / name).string();
+		}
+
+	private:
+
+		std::filesystem::path dir_;
+};
+
+
+TEST_CASE("load files")
+{
+	TempFiles files{};
+	std::vector<std::string> paths{};
+
+	for (int i{0}; i < 100; ++i)
+		paths.push_back(files.add(std::to_string(i) + ".kcv",
+			u8"id: " + std::to_string(i) + u8"\nname: \"tenant\"\n"));
+
+	kcv::LoadOptions options{};
+
+	SUBCASE("hardware concurrency")
+	{
+	}
+	SUBCASE("single thread")
+	{
+		options.threadCount = 1;
+	}
+	SUBCASE("more threads than files")
+	{
+		options.threadCount = 200;
+	}
+
+	std::vector<kcv::LoadResult> results{kcv::loadAll(paths, options)};
+	REQUIRE(results.size() == paths.size());
+
+	for (std::size_t i{0}; i < results.size(); ++i)
+	{
+		REQUIRE(results[i]);
+		std::size_t id{0};
+		results[i].document[u8"id"] >> id;
+		REQUIRE(id == i);
+	}
+}
+
+
+TEST_CASE("load files with errors")
+{
+	TempFiles files{};
+
+	const std::vector<std::string> paths{
+		files.add(u8"good.kcv", u8"a: 1"),
+		files.missing(u8"missing.kcv"),
+		files.add(u8"bad.kcv", u8"a: 1\nb: 2 !\n"),
+		files.add(u8"duplicate.kcv", u8"a: 1 a: 2"),
+		files.add(u8"empty.kcv", u8""),
+		files.add(u8"limit.kcv", u8"a: 1 b: 2 c: 3")};
+
+	kcv::LoadOptions options{};
+	options.maxItemCount = 2;
+
+	std::vector<kcv::LoadResult> results{kcv::loadAll(paths, options)};
+	REQUIRE(results.size() == paths.size());
+
+	using Status = kcv::LoadResult::Status;
+
+	REQUIRE(results[0]);
+	REQUIRE(results[0].status == Status::ok);
+
+	REQUIRE_FALSE(results[1]);
+	REQUIRE(results[1].status == Status::readFailed);
+
+	REQUIRE_FALSE(results[2]);
+	REQUIRE(results[2].status == Status::parseFailed);
+	REQUIRE(results[2].errorPos == 10);
+
+	REQUIRE_FALSE(results[3]);
+	REQUIRE(results[3].status == Status::parseFailed);
+	REQUIRE(results[3].errorPos == 5);
+
+	REQUIRE(results[4]);
+	REQUIRE(results[4].status == Status::ok);
+
+	REQUIRE_FALSE(results[5]);
+	REQUIRE(results[5].status == Status::parseFailed);
+	REQUIRE(results[5].errorPos == 10);
+
+	for (const kcv::LoadResult& result : results)
+	{
+		REQUIRE_FALSE(result.exception);
+		REQUIRE(static_cast<bool>(result.document) == static_cast<bool>(result));
+	}
+}
+
+
+TEST_CASE("load file with error at the first byte")
+{
+	TempFiles files{};
+	const std::vector<std::string> paths{files.add(u8"bad.kcv", u8"!")};
+
+	std::vector<kcv::LoadResult> results{kcv::loadAll(paths)};
+	REQUIRE(results.size() == 1);
+	REQUIRE_FALSE(results[0]);
+	REQUIRE(results[0].status == kcv::LoadResult::Status::parseFailed);
+	REQUIRE(results[0].errorPos == 0);
+	REQUIRE_FALSE(results[0].document);
+}
+
+
+TEST_CASE("load no files")
+{
+	REQUIRE(kcv::loadAll({}).empty());
+}
@@ -0,0 +1,97 @@
+struct BindTarget
+{
+	bool flag{false};
+	int count{1};
+	double ratio{1.0};
+	std::string name{};
+	std::string_view view{};
+};
+
+constexpr auto bindSchema{kcv::schema(
+	kcv::field(u8"flag",  &BindTarget::flag),
+	kcv::field(u8"count", &BindTarget::count),
+	kcv::field(u8"ratio", &BindTarget::ratio),
+	kcv::field(u8"name",  &BindTarget::name),
+	kcv::field(u8"view",  &BindTarget::view))};
+
+
+TEST_CASE("read items with bind")
+{
+	BindTarget target{};
+
+	SUBCASE("all fields")
+	{
+		std::string data{u8"name:\"A\\tB\" count:42 flag:yes ratio:0.5 view:\"V\""};
+		REQUIRE(kcv::bind(data, target, bindSchema));
+		REQUIRE(target.flag == true);
+		REQUIRE(target.count == 42);
+		REQUIRE(target.ratio == 0.5);
+		REQUIRE(target.name == u8"A\tB");
+		REQUIRE(target.view == u8"V");
+	}
+	SUBCASE("empty data")
+	{
+		REQUIRE(kcv::bind(u8"", target, bindSchema));
+		REQUIRE(target.count == 1);
+	}
+	SUBCASE("leading BOM")
+	{
+		REQUIRE(kcv::bind(u8"\xEF\xBB\xBF" u8"count:42", target, bindSchema));
+		REQUIRE(target.count == 42);
+	}
+	SUBCASE("missing fields are left unchanged")
+	{
+		REQUIRE(kcv::bind(u8"count:42", target, bindSchema));
+		REQUIRE(target.count == 42);
+		REQUIRE(target.flag == false);
+		REQUIRE(target.ratio == 1.0);
+	}
+	SUBCASE("unknown keys are ignored")
+	{
+		REQUIRE(kcv::bind(u8"other:1 2 3 count:42 more:", target, bindSchema));
+		REQUIRE(target.count == 42);
+	}
+	SUBCASE("rejectMissingKeys")
+	{
+		kcv::BindOptions options{};
+		options.rejectMissingKeys = true;
+		REQUIRE_FALSE(kcv::bind(u8"count:42", target, bindSchema, options));
+		REQUIRE(kcv::bind(u8"flag:no count:2 ratio:1 name:\"\" view:\"\"", target, bindSchema, options));
+	}
+	SUBCASE("rejectUnknownKeys")
+	{
+		kcv::BindOptions options{};
+		options.rejectUnknownKeys = true;
+		REQUIRE_FALSE(kcv::bind(u8"count:42 other:1", target, bindSchema, options));
+		REQUIRE(kcv::bind(u8"count:42", target, bindSchema, options));
+	}
+	SUBCASE("wrong value type")
+	{
+		REQUIRE_FALSE(kcv::bind(u8"count:yes", target, bindSchema));
+		REQUIRE(target.count == 1);
+	}
+	SUBCASE("escaped string for string_view")
+	{
+		REQUIRE_FALSE(kcv::bind(u8"view:\"\\t\"", target, bindSchema));
+	}
+	SUBCASE("missing value")
+	{
+		REQUIRE_FALSE(kcv::bind(u8"count: flag:yes", target, bindSchema));
+	}
+	SUBCASE("too many values")
+	{
+		REQUIRE_FALSE(kcv::bind(u8"count:1 2", target, bindSchema));
+	}
+	SUBCASE("duplicate key")
+	{
+		REQUIRE_FALSE(kcv::bind(u8"count:1 count:2", target, bindSchema));
+	}
+	SUBCASE("value before first key")
+	{
+		REQUIRE_FALSE(kcv::bind(u8"1 count:2", target, bindSchema));
+	}
+	SUBCASE("invalid syntax in unknown item")
+	{
+		REQUIRE_FALSE(kcv::bind(u8"count:1 other:\"", target, bindSchema));
+	}
+}
@@ -0,0 +1,107 @@
+TEST_CASE("read cached values")
+{
+	kcv::Document doc{u8"a: 1 2.5 yes b: \"x\" 7"};
+	REQUIRE(doc);
+	doc.cacheValues(true);
+
+	int i{0};
+	double d{0};
+	bool b{false};
+	std::string s{};
+
+	SUBCASE("repeated reads")
+	{
+		for (int n{0}; n < 3; ++n)
+		{
+			REQUIRE(doc[u8"a"].read(i, d, b));
+			REQUIRE(i == 1);
+			REQUIRE(d == 2.5);
+			REQUIRE(b == true);
+			REQUIRE(doc[u8"a"] >> d);
+			REQUIRE(d == 1.0);
+		}
+	}
+	SUBCASE("failed reads")
+	{
+		for (int n{0}; n < 2; ++n)
+		{
+			i = 3;
+			REQUIRE_FALSE(doc[u8"b"] >> i);
+			REQUIRE(i == 3);
+			REQUIRE(doc[u8"b"] >> s >> i);
+			REQUIRE(s == u8"x");
+			REQUIRE(i == 7);
+		}
+	}
+	SUBCASE("invalidate on write")
+	{
+		REQUIRE(doc[u8"a"] >> i);
+		doc[u8"a"] << 5;
+		REQUIRE(doc[u8"a"] >> i);
+		REQUIRE(i == 5);
+		doc[u8"a"].write(6, 7);
+		REQUIRE(doc[u8"a"] >> i >> i);
+		REQUIRE(i == 7);
+	}
+	SUBCASE("invalidate on iterated write")
+	{
+		REQUIRE(doc[u8"a"] >> i);
+		for (auto [key, item] : doc)
+			item << 9;
+		REQUIRE(doc[u8"a"] >> i);
+		REQUIRE(i == 9);
+	}
+	SUBCASE("invalidate on reparse")
+	{
+		std::string data{u8"a: 1 2.5 yes b: \"x\" 7"};
+		kcv::Document other{data};
+		other.cacheValues(true);
+		REQUIRE(other[u8"a"] >> i);
+		REQUIRE(other.reparse(data, u8"a: 4 2.5 yes b: \"x\" 7"));
+		REQUIRE(other[u8"a"] >> i);
+		REQUIRE(i == 4);
+	}
+	SUBCASE("copy and disable")
+	{
+		REQUIRE(doc[u8"a"] >> i);
+		kcv::Document copy{doc};
+		copy[u8"a"] << 8;
+		REQUIRE(doc[u8"a"] >> i);
+		REQUIRE(i == 1);
+		REQUIRE(copy[u8"a"] >> i);
+		REQUIRE(i == 8);
+
+		doc.cacheValues(false);
+		doc[u8"a"] << 2;
+		REQUIRE(doc[u8"a"] >> i);
+		REQUIRE(i == 2);
+	}
+}
+
+
+TEST_CASE("read cached values of types with equal size")
+{
+	// The cache distinguishes the types themselves,
+	// not only their size or representation
+	kcv::Document doc{u8"a: 1.5 -1"};
+	doc.cacheValues(true);
+
+	double d{0};
+	std::int64_t i{0};
+	std::uint64_t u{0};
+	float f{0};
+	std::int32_t j{0};
+
+	for (int n{0}; n < 2; ++n)
+	{
+		REQUIRE(doc[u8"a"] >> d);
+		REQUIRE(d == 1.5);
+		REQUIRE_FALSE(doc[u8"a"] >> i);
+		REQUIRE(doc[u8"a"] >> f);
+		REQUIRE(f == 1.5f);
+		REQUIRE_FALSE(doc[u8"a"] >> j);
+		REQUIRE(doc[u8"a"] >> d >> i);
+		REQUIRE(i == -1);
+		REQUIRE_FALSE(doc[u8"a"] >> d >> u);
+	}
+}
@@ -0,0 +1,34 @@
+// Compile-time parsing depends on compiler support
+#if defined(KCV_HAS_IS_CONSTANT_EVALUATED) && !defined(KCV_ENABLE_STATS)
+
+constexpr kcv::DocumentView<4> embeddedView{u8"port: 8080\nname: \"Foo\"\ndebug: yes\n"};
+constexpr kcv::DocumentView<4, 8> embeddedTape{u8"c: 3 b: 2 22 a: 1"};
+
+static_assert(embeddedView, "embedded view is parsed at compile time");
+static_assert(embeddedTape, "embedded tape is parsed at compile time");
+static_assert(!kcv::DocumentView<4>{u8"a: 1 a: 2"}, "duplicate key fails at compile time");
+static_assert(!kcv::DocumentView<4>{u8"a: 1 ! b: 2"}, "invalid token fails at compile time");
+static_assert(!kcv::DocumentView<1>{u8"a: 1 b: 2"}, "item limit fails at compile time");
+static_assert(kcv::DocumentView<4>{u8""}, "empty data is parsed at compile time");
+
+
+TEST_CASE("read item from compile-time DocumentView")
+{
+	int i{0};
+	std::string_view v{};
+	bool b{false};
+
+	embeddedView[u8"port"] >> i;
+	REQUIRE(i == 8080);
+	embeddedView[u8"name"] >> v;
+	REQUIRE(v == u8"Foo");
+	embeddedView[u8"debug"] >> b;
+	REQUIRE(b == true);
+	REQUIRE_FALSE(embeddedView[u8"other"]);
+
+	embeddedTape[u8"b"] >> i >> i;
+	REQUIRE(i == 22);
+	REQUIRE(embeddedTape[u8"a"].size() == 1);
+}
+
+#endif // KCV_HAS_IS_CONSTANT_EVALUATED
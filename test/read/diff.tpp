@@ -0,0 +1,90 @@
+TEST_CASE_TEMPLATE("diff documents", D, kcv::Document, kcv::DocumentView<8>, kcv::DocumentView<8, 16>)
+{
+	const std::string oldData{u8"a: 1\nb: 2 3\nc: \"x\"\nd:\n"};
+	const std::string newData{u8"b:   2 3  \nc: \"y\"\nd: 4\ne: yes\n"};
+	const D a{oldData};
+	const D b{newData};
+	REQUIRE(a);
+	REQUIRE(b);
+
+	using Type = kcv::Change::Type;
+
+	SUBCASE("changes")
+	{
+		const kcv::Patch patch{kcv::diff(a, b)};
+		REQUIRE(patch.size() == 4);
+		REQUIRE(patch[0].type == Type::removed);
+		REQUIRE(patch[0].key == u8"a");
+		REQUIRE(patch[1].type == Type::changed);
+		REQUIRE(patch[1].key == u8"c");
+		REQUIRE(patch[1].values == u8" \"y\"\n");
+		REQUIRE(patch[2].type == Type::changed);
+		REQUIRE(patch[2].key == u8"d");
+		REQUIRE(patch[3].type == Type::added);
+		REQUIRE(patch[3].key == u8"e");
+	}
+	SUBCASE("equal documents")
+	{
+		REQUIRE(kcv::diff(a, a).empty());
+		REQUIRE(kcv::diff(a, kcv::Document{oldData}).empty());
+	}
+	SUBCASE("empty documents")
+	{
+		REQUIRE(kcv::diff(a, D{}).size() == 4);
+		REQUIRE(kcv::diff(D{}, b).size() == 4);
+		REQUIRE(kcv::diff(a, D{u8"a: 1 a: 2"}).size() == 4);
+	}
+	SUBCASE("apply")
+	{
+		kcv::Document doc{oldData};
+		auto item{doc[u8"b"]};
+
+		REQUIRE(kcv::apply(doc, kcv::diff(a, b)));
+		REQUIRE(kcv::diff(doc, b).empty());
+		REQUIRE(doc.dump() == u8"b: 2 3\nc: \"y\"\nd: 4\ne: yes\n");
+
+		// Unchanged items remain valid
+		item << 5;
+		REQUIRE(doc.dump() == u8"b: 5\nc: \"y\"\nd: 4\ne: yes\n");
+	}
+	SUBCASE("apply to a different document")
+	{
+		kcv::Document doc{u8"c: 0 e: 0"};
+		REQUIRE_FALSE(kcv::apply(doc, kcv::diff(a, b)));
+		REQUIRE(doc.dump() == u8"c: \"y\"\nd: 4\ne: yes\n");
+	}
+}
+
+
+TEST_CASE("diff and apply random documents")
+{
+	std::uint32_t seed{1};
+	auto random = [&seed](std::uint32_t range)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		return (seed >> 8) % range;
+	};
+
+	for (int round{0}; round < 200; ++round)
+	{
+		std::string oldData{};
+		std::string newData{};
+
+		for (std::uint32_t key{0}; key < 64; ++key)
+		{
+			const std::string line{u8"k" + std::to_string(key) + u8": "};
+			if (random(4) != 0)
+				oldData += line + std::to_string(random(3)) + u8"\n";
+			if (random(4) != 0)
+				newData += line + std::to_string(random(3)) + u8"\n";
+		}
+
+		kcv::Document doc{oldData};
+		const kcv::DocumentView<64> view{newData};
+		REQUIRE(doc);
+		REQUIRE(view);
+
+		REQUIRE(kcv::apply(doc, kcv::diff(doc, view)));
+		REQUIRE(doc.dump() == kcv::Document{newData}.dump());
+	}
+}
@@ -0,0 +1,48 @@
+TEST_CASE("dump DocumentView")
+{
+	const std::vector<std::string> inputs{
+		u8"",
+		u8"a: 1",
+		u8"\xEF\xBB\xBF" u8"b: 2\r\na:1 2  \n\n c:\td: \"x\"\n",
+		u8"z: yes y: no x:\n",
+		u8"net.tcp: 80 net: 0 net-a: -1.5e3 \"\\u00e9\"\n"};
+
+	for (const std::string& data : inputs)
+	{
+		const kcv::DocumentView<8> view{data};
+		REQUIRE(view);
+
+		const std::string expected{kcv::Document{data}.dump()};
+		REQUIRE(view.dumpSize() == expected.size());
+
+		std::string out(expected.size(), '#');
+		REQUIRE(view.dumpTo(out.data(), out.size()) == expected.size());
+		REQUIRE(out == expected);
+	}
+
+	SUBCASE("small buffer")
+	{
+		const kcv::DocumentView<8> view{u8"a: 1"};
+		char out[4]{'#', '#', '#', '#'};
+		REQUIRE(view.dumpTo(out, sizeof(out)) == 5);
+		REQUIRE(out[0] == '#');
+	}
+	SUBCASE("invalid document")
+	{
+		const kcv::DocumentView<8> view{u8"a: 1 a: 2"};
+		REQUIRE_FALSE(view);
+		REQUIRE(view.dumpSize() == 0);
+		REQUIRE(view.dumpTo(nullptr, 0) == 0);
+	}
+	SUBCASE("after reparse")
+	{
+		const std::string old{u8"b: 2 a: 1"};
+		const std::string data{u8"b: 2 c: 3 a: 1"};
+		kcv::DocumentView<8> view{old};
+		REQUIRE(view.reparse(data));
+
+		std::string out(view.dumpSize(), '#');
+		view.dumpTo(out.data(), out.size());
+		REQUIRE(out == kcv::Document{data}.dump());
+	}
+}
@@ -399,3 +399,58 @@ TEST_CASE("read item from limited DocumentView")
 		REQUIRE(a == 1);
 	}
 }
+
+
+TEST_CASE_TEMPLATE("read item values at once", D, kcv::Document, kcv::DocumentView<8>)
+{
+	int i{1};
+	bool b{false};
+	std::string s{};
+
+	SUBCASE("all values")
+	{
+		std::string data{u8"a:11 yes \"A\""};
+		D doc{data};
+		auto item{doc[u8"a"]};
+		item.read(i, b, s);
+		REQUIRE(item);
+		REQUIRE(i == 11);
+		REQUIRE(b == true);
+		REQUIRE(s == u8"A");
+	}
+	SUBCASE("continue after previous read")
+	{
+		std::string data{u8"a:11 22 33"};
+		D doc{data};
+		int j{1};
+		auto item{doc[u8"a"]};
+		item >> i;
+		item.read(i, j);
+		REQUIRE(item);
+		REQUIRE(i == 22);
+		REQUIRE(j == 33);
+	}
+	SUBCASE("missing value")
+	{
+		std::string data{u8"a:11 yes"};
+		D doc{data};
+		auto item{doc[u8"a"]};
+		item.read(i, b, s);
+		REQUIRE_FALSE(item);
+		REQUIRE(i == 11);
+		REQUIRE(b == true);
+		REQUIRE(s == u8"");
+	}
+	SUBCASE("stop at invalid value")
+	{
+		std::string data{u8"a:11 22 yes"};
+		D doc{data};
+		auto item{doc[u8"a"]};
+		int j{1};
+		item.read(i, b, j);
+		REQUIRE_FALSE(item);
+		REQUIRE(i == 11);
+		REQUIRE(b == false);
+		REQUIRE(j == 1);
+	}
+}
@@ -0,0 +1,185 @@
+TEST_CASE_TEMPLATE("iterate over items", D, kcv::Document, kcv::DocumentView<8>, kcv::DocumentView<8, 8>)
+{
+	std::string data{u8"c: 3 a: 1 d: 4 b: 2"};
+	const D doc{data};
+	REQUIRE(doc);
+
+	std::string keys{};
+	int sum{0};
+
+	SUBCASE("all items")
+	{
+		for (auto [key, item] : doc)
+		{
+			int i{0};
+			item >> i;
+			keys.append(key);
+			sum += i;
+		}
+		REQUIRE(keys == u8"abcd");
+		REQUIRE(sum == 10);
+	}
+	SUBCASE("reverse")
+	{
+		auto it{doc.end()};
+		while (it != doc.begin())
+			keys.append((*--it).first);
+		REQUIRE(keys == u8"dcba");
+	}
+	SUBCASE("range")
+	{
+		for (auto [key, item] : doc.range(u8"b", u8"d"))
+			keys.append(key);
+		REQUIRE(keys == u8"bc");
+	}
+	SUBCASE("range with absent bounds")
+	{
+		for (auto [key, item] : doc.range(u8"aa", u8"zz"))
+			keys.append(key);
+		REQUIRE(keys == u8"bcd");
+	}
+	SUBCASE("empty range")
+	{
+		REQUIRE(doc.range(u8"b", u8"b").begin() == doc.range(u8"b", u8"b").end());
+		REQUIRE(doc.range(u8"d", u8"a").begin() == doc.range(u8"d", u8"a").end());
+	}
+}
+
+
+TEST_CASE_TEMPLATE("iterate over empty document", D, kcv::Document, kcv::DocumentView<8>, kcv::DocumentView<8, 8>)
+{
+	SUBCASE("default")
+	{
+		const D doc{};
+		REQUIRE(doc.begin() == doc.end());
+	}
+	SUBCASE("empty data")
+	{
+		const D doc{u8"  "};
+		REQUIRE(doc.begin() == doc.end());
+	}
+	SUBCASE("failed data")
+	{
+		const D doc{u8"a: 1 a: 2"};
+		REQUIRE(doc.begin() == doc.end());
+	}
+}
+
+
+TEST_CASE_TEMPLATE("iterate over items in source order", D, kcv::DocumentView<8>, kcv::DocumentView<8, 8>)
+{
+	std::string keys{};
+	std::vector<int> values{};
+
+	SUBCASE("items")
+	{
+		D doc{u8"\xEF\xBB\xBF c: 3 33 a: 1\nd: b: 2 "};
+		for (auto [key, item] : doc.sourceOrder())
+		{
+			keys.append(key);
+			int i{0};
+			while (item >> i)
+				values.push_back(i);
+		}
+		REQUIRE(keys == u8"cadb");
+		REQUIRE(values == std::vector<int>{3, 33, 1, 2});
+	}
+	SUBCASE("empty data")
+	{
+		D doc{u8""};
+		REQUIRE(doc.sourceOrder().begin() == doc.sourceOrder().end());
+	}
+	SUBCASE("failed data")
+	{
+		D doc{u8"a: 1 a: 2"};
+		REQUIRE(doc.sourceOrder().begin() == doc.sourceOrder().end());
+	}
+}
+
+
+TEST_CASE_TEMPLATE("random access to items", D, kcv::DocumentView<8>, kcv::DocumentView<8, 8>)
+{
+	D doc{u8"c: 3 a: 1 d: 4 b: 2"};
+	int i{0};
+
+	REQUIRE(doc.end() - doc.begin() == 4);
+	REQUIRE(doc.begin()[2].first == u8"c");
+	doc.begin()[2].second >> i;
+	REQUIRE(i == 3);
+
+	auto it{doc.end() - 3};
+	REQUIRE((*it).first == u8"b");
+	it += 2;
+	REQUIRE((*it--).first == u8"d");
+	REQUIRE((*it).first == u8"c");
+	REQUIRE(doc.end() - it == 2);
+}
+
+
+TEST_CASE("iterators yield pairs by value")
+{
+	// The yielded pairs are proxies, so the iterators must
+	// not claim a stronger category than input iterator.
+	using Input = std::input_iterator_tag;
+	using ViewIt = decltype(std::declval<kcv::DocumentView<8>>().begin());
+	using SourceIt = decltype(std::declval<kcv::DocumentView<8>>().sourceOrder().begin());
+	using DocIt = decltype(std::declval<kcv::Document&>().begin());
+	using ConstDocIt = decltype(std::declval<const kcv::Document&>().begin());
+
+	REQUIRE(std::is_same_v<std::iterator_traits<ViewIt>::iterator_category, Input>);
+	REQUIRE(std::is_same_v<std::iterator_traits<SourceIt>::iterator_category, Input>);
+	REQUIRE(std::is_same_v<std::iterator_traits<DocIt>::iterator_category, Input>);
+	REQUIRE(std::is_same_v<std::iterator_traits<ConstDocIt>::iterator_category, Input>);
+}
+
+
+TEST_CASE("iterate over subtree")
+{
+	kcv::DocumentView<8> doc{u8"net.udp: 2 net: 0 net.tcp: 1 netx: 3 a: 4"};
+	auto net{doc.subtree(u8"net")};
+
+	std::string keys{};
+	for (auto [key, item] : net)
+		keys.append(key).push_back(' ');
+	REQUIRE(keys == u8"tcp udp ");
+
+	REQUIRE(net.end() - net.begin() == 2);
+	REQUIRE(net.range(u8"u", u8"v").end() - net.range(u8"u", u8"v").begin() == 1);
+}
+
+
+TEST_CASE("iterate over Document subtree")
+{
+	kcv::Document doc{u8"net.udp: 2\nnet: 0\nnet.tcp: 1\nnetx: 3\na: 4\nnet.tcp.port: 5\n"};
+
+	std::string keys{};
+	for (auto [key, item] : doc.subtree(u8"net"))
+	{
+		keys.append(key).push_back(' ');
+		item << 0;
+	}
+	REQUIRE(keys == u8"tcp tcp.port udp ");
+	REQUIRE(doc.dump() == u8"a: 4\nnet: 0\nnet.tcp: 0\nnet.tcp.port: 0\nnet.udp: 0\nnetx: 3\n");
+
+	const kcv::Document& constDoc{doc};
+	keys.clear();
+	for (auto [key, item] : constDoc.subtree(u8"net").range(u8"tcp.", u8"v"))
+		keys.append(key).push_back(' ');
+	REQUIRE(keys == u8"tcp.port udp ");
+
+	auto tcp{doc.subtree(u8"net").subtree(u8"tcp")};
+	REQUIRE((*tcp.begin()).first == u8"port");
+	REQUIRE(std::distance(tcp.begin(), tcp.end()) == 1);
+	REQUIRE(doc.subtree(u8"net").range(u8"v", u8"u").begin() == doc.subtree(u8"net").range(u8"v", u8"u").end());
+}
+
+
+TEST_CASE("write items while iterating")
+{
+	kcv::Document doc{u8"a: 1 b: 2"};
+
+	for (auto [key, item] : doc)
+		item << 0;
+
+	REQUIRE(doc.dump() == u8"a: 0\nb: 0\n");
+}
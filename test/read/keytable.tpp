@@ -0,0 +1,72 @@
+TEST_CASE("intern keys in a shared table")
+{
+	kcv::KeyTable table{};
+	REQUIRE(table.size() == 0);
+
+	const auto a{table.intern(u8"a.b")};
+	const auto b{table.intern(u8"c")};
+	REQUIRE(a != b);
+	REQUIRE(table.intern(u8"a.b") == a);
+	REQUIRE(table.find(u8"c") == b);
+	REQUIRE(table.find(u8"d") == kcv::KeyTable::none);
+	REQUIRE(table.key(a) == u8"a.b");
+	REQUIRE(table.key(b) == u8"c");
+	REQUIRE(table.key(kcv::KeyTable::none).empty());
+	REQUIRE(table.size() == 2);
+
+	REQUIRE(table.intern(u8"") == kcv::KeyTable::none);
+	REQUIRE(table.intern(u8"a b") == kcv::KeyTable::none);
+	REQUIRE(table.intern(u8"1a") == kcv::KeyTable::none);
+	REQUIRE(table.size() == 2);
+}
+
+
+TEST_CASE("read and write interned documents")
+{
+	kcv::KeyTable table{};
+	int i{0};
+
+	SUBCASE("share keys")
+	{
+		kcv::InternedDocument x{table, u8"port: 80 host: \"a\""};
+		kcv::InternedDocument y{table, u8"host: \"b\" port: 81 user: \"c\""};
+		REQUIRE(x);
+		REQUIRE(y);
+		REQUIRE(table.size() == 3);
+
+		const auto port{table.find(u8"port")};
+		x[port] >> i;
+		REQUIRE(i == 80);
+		y[port] >> i;
+		REQUIRE(i == 81);
+		y[u8"port"] >> i;
+		REQUIRE(i == 81);
+	}
+	SUBCASE("insert items")
+	{
+		kcv::InternedDocument doc{table};
+		REQUIRE(doc);
+		doc[u8"b"] << 2;
+		doc[u8"a"] << 1;
+		REQUIRE(table.size() == 2);
+		REQUIRE(doc.dump() == u8"a: 1\nb: 2\n");
+		REQUIRE_FALSE(doc[u8"a b"]);
+		REQUIRE_FALSE(doc[kcv::KeyTable::Id{7}]);
+		REQUIRE(table.size() == 2);
+	}
+	SUBCASE("match document dump")
+	{
+		const std::string data{u8"z: 1\n b:2 a.b: \"x\"\n\nc:"};
+		kcv::InternedDocument doc{table, data};
+		REQUIRE(doc);
+		REQUIRE(doc.dump() == kcv::Document{data}.dump());
+	}
+	SUBCASE("reject invalid data")
+	{
+		REQUIRE_FALSE(kcv::InternedDocument{table, u8"a: 1 a: 2"});
+		REQUIRE_FALSE(kcv::InternedDocument{table, u8"1"});
+		REQUIRE_FALSE(kcv::InternedDocument{table, u8"a: \"x"});
+		REQUIRE_FALSE(kcv::InternedDocument{table, u8"a: 1 b: 2", 1});
+		REQUIRE(kcv::InternedDocument{table, u8"a: 1 b: 2", 2});
+	}
+}
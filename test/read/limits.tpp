@@ -0,0 +1,83 @@
+TEST_CASE_TEMPLATE("parse with limits", D, kcv::Document, kcv::DocumentView<8>, kcv::DocumentView<8, 8>)
+{
+	const std::string data{u8"a: 1 2 3 bb: \"xyz\" c:"};
+	kcv::ParseLimits limits{};
+
+	SUBCASE("no limits")
+	{
+		REQUIRE(D{data, limits});
+	}
+	SUBCASE("data size")
+	{
+		limits.maxDataSize = data.size();
+		REQUIRE(D{data, limits});
+		limits.maxDataSize = data.size() - 1;
+		REQUIRE_FALSE(D{data, limits});
+	}
+	SUBCASE("item count")
+	{
+		limits.maxItemCount = 3;
+		REQUIRE(D{data, limits});
+		limits.maxItemCount = 2;
+		REQUIRE_FALSE(D{data, limits});
+	}
+	SUBCASE("item size")
+	{
+		limits.maxItemSize = 9;
+		REQUIRE(D{data, limits});
+		limits.maxItemSize = 8;
+		REQUIRE_FALSE(D{data, limits});
+		limits.maxItemSize = 1;
+		REQUIRE_FALSE(D{u8"a:", limits});
+		limits.maxItemSize = 2;
+		REQUIRE(D{u8"a:", limits});
+	}
+	SUBCASE("item size stops long tokens")
+	{
+		limits.maxItemSize = 6;
+		REQUIRE(D{u8"a: 123", limits});
+		REQUIRE_FALSE(D{u8"a: 1234", limits});
+		REQUIRE_FALSE(D{u8"a: 12345678", limits});
+		REQUIRE(D{u8"a: 1\nabcde:", limits});
+		REQUIRE_FALSE(D{u8"a: 1\nabcdef:", limits});
+		REQUIRE_FALSE(D{u8"a: \"" + std::string(1000, 'x') + u8"\"", limits});
+	}
+	SUBCASE("key size")
+	{
+		limits.maxKeySize = 2;
+		REQUIRE(D{data, limits});
+		limits.maxKeySize = 1;
+		REQUIRE_FALSE(D{data, limits});
+	}
+	SUBCASE("value count")
+	{
+		limits.maxValueCount = 3;
+		REQUIRE(D{data, limits});
+		limits.maxValueCount = 2;
+		REQUIRE_FALSE(D{data, limits});
+	}
+	SUBCASE("reading is unaffected")
+	{
+		limits.maxItemSize = 9;
+		limits.maxValueCount = 3;
+		D doc{data, limits};
+		REQUIRE(doc);
+		int i{0};
+		REQUIRE(doc[u8"a"].read(i, i, i));
+		REQUIRE(i == 3);
+	}
+}
+
+
+TEST_CASE("parse Document with memory limit")
+{
+	const std::string data{u8"a: 1 b: 2 c: 3"};
+	kcv::ParseLimits limits{};
+
+	limits.maxMemory = 1024;
+	REQUIRE(kcv::Document{data, limits});
+	limits.maxMemory = 8;
+	REQUIRE_FALSE(kcv::Document{data, limits});
+	limits.maxMemory = 1024;
+	REQUIRE_FALSE(kcv::Document{std::string(2000, ' ') + data + u8" " + std::string(2000, '1'), limits});
+}
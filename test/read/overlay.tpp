@@ -0,0 +1,119 @@
+TEST_CASE("read item from Overlay")
+{
+	std::string defaultData{u8"a:1 b:1 c:1 d:1"};
+	std::string siteData{u8"b:2 c:2 e:2"};
+	std::string hostData{u8"c:3 f:3 0"};
+
+	kcv::DocumentView<8> defaults{defaultData};
+	kcv::Document site{siteData};
+	kcv::DocumentView<8, 8> host{hostData};
+	kcv::Document runtime{};
+	runtime[u8"d"] << 4 << 44;
+
+	kcv::Overlay overlay{};
+	overlay.push(defaults);
+	overlay.push(site);
+	overlay.push(host);
+	overlay.push(runtime);
+
+	int i{0};
+	int j{0};
+
+	SUBCASE("unindexed")
+	{
+	}
+	SUBCASE("indexed")
+	{
+		overlay.index();
+	}
+
+	overlay[u8"a"] >> i;
+	REQUIRE(i == 1);
+	overlay[u8"b"] >> i;
+	REQUIRE(i == 2);
+	overlay[u8"c"] >> i >> j;
+	REQUIRE(i == 3);
+	REQUIRE(j == 0);
+	overlay[u8"d"] >> i >> j;
+	REQUIRE(i == 4);
+	REQUIRE(j == 44);
+	overlay[u8"e"] >> i;
+	REQUIRE(i == 2);
+	overlay[u8"f"] >> i;
+	REQUIRE(i == 3);
+	REQUIRE_FALSE(overlay[u8"g"]);
+	REQUIRE_FALSE(overlay[u8""]);
+}
+
+
+TEST_CASE("read item from empty Overlay")
+{
+	kcv::Overlay overlay{};
+
+	SUBCASE("no layer")
+	{
+		REQUIRE_FALSE(overlay[u8"a"]);
+		overlay.index();
+		REQUIRE_FALSE(overlay[u8"a"]);
+	}
+	SUBCASE("failed layers are empty")
+	{
+		std::string data{u8"a:1 a:2"};
+		kcv::Document doc{data};
+		kcv::DocumentView<8> view{data};
+		overlay.push(doc);
+		overlay.push(view);
+		REQUIRE_FALSE(overlay[u8"a"]);
+		overlay.index();
+		REQUIRE_FALSE(overlay[u8"a"]);
+	}
+	SUBCASE("push discards index")
+	{
+		kcv::Document a{u8"a:1"};
+		kcv::Document b{u8"a:2 b:2"};
+		int i{0};
+		overlay.push(a);
+		overlay.index();
+		overlay.push(b);
+		overlay[u8"a"] >> i;
+		REQUIRE(i == 2);
+		overlay[u8"b"] >> i;
+		REQUIRE(i == 2);
+	}
+}
+
+
+TEST_CASE("index Overlay with many layers")
+{
+	// Every layer l defines the keys k0..kl, so
+	// key k is answered by the highest layer.
+	constexpr int layerCount{9};
+	std::vector<kcv::Document> layers(layerCount);
+	kcv::Overlay overlay{};
+
+	for (int l{0}; l < layerCount; ++l)
+	{
+		for (int k{0}; k <= l; ++k)
+			layers[l]["k" + std::to_string(k)] << l;
+		overlay.push(layers[l]);
+	}
+
+	overlay.index();
+
+	for (int k{0}; k < layerCount; ++k)
+	{
+		int i{-1};
+		overlay["k" + std::to_string(k)] >> i;
+		REQUIRE(i == layerCount - 1);
+	}
+	REQUIRE_FALSE(overlay["k" + std::to_string(layerCount)]);
+
+	// Lower layers still answer keys the top layer lacks
+	layers[layerCount - 1] = kcv::Document{u8"k8:8"};
+	overlay.index();
+	int i{-1};
+	overlay[u8"k0"] >> i;
+	REQUIRE(i == 7);
+	overlay[u8"k8"] >> i;
+	REQUIRE(i == 8);
+}
@@ -0,0 +1,56 @@
+TEST_CASE_TEMPLATE("iterate over values", D, kcv::Document, kcv::DocumentView<8>, kcv::DocumentView<8, 16>)
+{
+	D doc{u8"a: 1 2 3 \"x\" 4 b: yes 0x1F -2.5 \"y\\n\" c:"};
+	REQUIRE(doc);
+
+	SUBCASE("typed values")
+	{
+		std::vector<int> out{};
+		for (int i : doc[u8"a"].template values<int>())
+			out.push_back(i);
+		REQUIRE(out == std::vector<int>{1, 2, 3});
+	}
+	SUBCASE("standard algorithms")
+	{
+		auto values{doc[u8"a"].template values<double>()};
+		double sum{0};
+		std::for_each(values.begin(), values.end(), [&](double d) { sum += d; });
+		REQUIRE(sum == 6.0);
+
+		auto strings{doc[u8"a"].template values<std::string>()};
+		REQUIRE(std::distance(strings.begin(), strings.end()) == 0);
+	}
+	SUBCASE("from read position")
+	{
+		auto item{doc[u8"a"]};
+		int i{0};
+		REQUIRE(item >> i >> i >> i);
+
+		std::string s{};
+		for (const std::string& value : item.template values<std::string>())
+			s += value;
+		REQUIRE(s == u8"x");
+
+		REQUIRE(item >> s);
+		REQUIRE(s == u8"x");
+	}
+	SUBCASE("raw tokens")
+	{
+		std::vector<kcv::Token::Type> types{};
+		std::string text{};
+		for (const kcv::Token& token : doc[u8"b"].tokens())
+		{
+			types.push_back(token.type());
+			text += token.text();
+		}
+		REQUIRE(types == std::vector<kcv::Token::Type>{kcv::Token::Type::boolYes,
+			kcv::Token::Type::numHex, kcv::Token::Type::numFloat, kcv::Token::Type::strEscaped});
+		REQUIRE(text == u8"yes0x1F-2.5\"y\\n\"");
+	}
+	SUBCASE("empty and absent items")
+	{
+		REQUIRE(doc[u8"c"].tokens().begin() == doc[u8"c"].tokens().end());
+		auto absent{doc[u8"d"].template values<int>()};
+		REQUIRE(absent.begin() == absent.end());
+	}
+}
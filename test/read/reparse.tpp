@@ -0,0 +1,268 @@
+template<typename D>
+std::string describe(const D& doc)
+{
+	// Lists the keys and integer values, or the
+	// position of the first non-integer value
+	std::string out{};
+
+	for (auto [key, item] : doc)
+	{
+		out.append(key).push_back(':');
+		for (std::size_t i{0}; i < item.size(); ++i)
+		{
+			int value{0};
+			if (item.at(i) >> value)
+				out.append(std::to_string(value));
+			out.push_back(' ');
+		}
+		out.push_back('\n');
+	}
+
+	return out;
+}
+
+
+TEST_CASE_TEMPLATE("reparse edited data", D, kcv::DocumentView<256>, kcv::DocumentView<256, 1024>)
+{
+	std::string oldData{u8"a: 1 c: 3 33\nb: 2\n"};
+	D doc{oldData};
+	REQUIRE(doc);
+
+	std::string newData{};
+	int i{0};
+
+	SUBCASE("same")
+	{
+		newData = oldData;
+		REQUIRE(doc.reparse(newData));
+		doc[u8"c"] >> i >> i;
+		REQUIRE(i == 33);
+	}
+	SUBCASE("value")
+	{
+		newData = u8"a: 1 c: 4 33\nb: 2\n";
+		REQUIRE(doc.reparse(newData));
+		doc[u8"c"] >> i;
+		REQUIRE(i == 4);
+		doc[u8"b"] >> i;
+		REQUIRE(i == 2);
+	}
+	SUBCASE("longer value")
+	{
+		newData = u8"a: 1 c: 3000 33\nb: 2\n";
+		REQUIRE(doc.reparse(newData));
+		doc[u8"c"] >> i;
+		REQUIRE(i == 3000);
+		doc[u8"b"] >> i;
+		REQUIRE(i == 2);
+	}
+	SUBCASE("key")
+	{
+		newData = u8"a: 1 d: 3 33\nb: 2\n";
+		REQUIRE(doc.reparse(newData));
+		REQUIRE_FALSE(doc[u8"c"]);
+		doc[u8"d"] >> i;
+		REQUIRE(i == 3);
+	}
+	SUBCASE("new items")
+	{
+		newData = u8"a: 1 c: 3 33\nf: 6 e: 5 d: 4\nb: 2\n";
+		REQUIRE(doc.reparse(newData));
+		REQUIRE(describe(doc) == u8"a:1 \nb:2 \nc:3 33 \nd:4 \ne:5 \nf:6 \n");
+	}
+	SUBCASE("removed key becomes value")
+	{
+		newData = u8"a: 1 c: 3 33\n2\n";
+		REQUIRE(doc.reparse(newData));
+		REQUIRE(describe(doc) == u8"a:1 \nc:3 33 2 \n");
+	}
+	SUBCASE("first key")
+	{
+		newData = u8"x: 1 c: 3 33\nb: 2\n";
+		REQUIRE(doc.reparse(newData));
+		REQUIRE(describe(doc) == u8"b:2 \nc:3 33 \nx:1 \n");
+	}
+	SUBCASE("duplicate key")
+	{
+		newData = u8"a: 1 c: 3 33\nb: 2\na: 4";
+		REQUIRE_FALSE(doc.reparse(newData));
+		REQUIRE_FALSE(doc[u8"a"]);
+	}
+	SUBCASE("invalid data")
+	{
+		newData = u8"a: 1 c: 3 ! 33\nb: 2\n";
+		REQUIRE_FALSE(doc.reparse(newData));
+		REQUIRE_FALSE(doc[u8"a"]);
+	}
+	SUBCASE("after failure")
+	{
+		newData = u8"a: 1 a: 2";
+		REQUIRE_FALSE(doc.reparse(newData));
+		REQUIRE(doc.reparse(oldData));
+		doc[u8"c"] >> i;
+		REQUIRE(i == 3);
+	}
+}
+
+
+TEST_CASE("reparse edited Document")
+{
+	std::string oldData{u8"a: 1 c: 3 33\nb: 2\n"};
+	kcv::Document doc{oldData};
+
+	SUBCASE("value and key")
+	{
+		REQUIRE(doc.reparse(oldData, u8"a: 1 d: 3 44\nb: 2 e: 5\n"));
+		REQUIRE(doc.dump() == u8"a: 1 \nb: 2 \nd: 3 44\ne: 5\n");
+	}
+	SUBCASE("removed key becomes value")
+	{
+		REQUIRE(doc.reparse(oldData, u8"a: 1 c: 3 33\n2\n"));
+		REQUIRE(doc.dump() == u8"a: 1 \nc: 3 33\n2\n");
+	}
+	SUBCASE("duplicate key")
+	{
+		REQUIRE_FALSE(doc.reparse(oldData, u8"a: 1 c: 3 33\nb: 2 c: 4\n"));
+		REQUIRE(doc.dump() == u8"");
+	}
+	SUBCASE("items of kept keys")
+	{
+		int i{0};
+		doc.cacheValues(true);
+		kcv::Item a{doc[u8"a"]};
+		kcv::Item b{doc[u8"b"]};
+		REQUIRE(doc[u8"b"] >> i);
+
+		// The node of c: is not reused for d:
+		REQUIRE(doc.reparse(oldData, u8"a: 1 d: 3 44\nb: 7\n"));
+		REQUIRE(b >> i);
+		REQUIRE(i == 7);
+		REQUIRE(a >> i);
+		REQUIRE(i == 1);
+		REQUIRE(doc.dump() == u8"a: 1 \nb: 7\nd: 3 44\n");
+	}
+	SUBCASE("different old data")
+	{
+		// The reparse detects that c: was never parsed
+		kcv::Document other{u8"a: 1"};
+		REQUIRE(other.reparse(oldData, u8"a: 1 c: 4 33\nb: 2\n"));
+		REQUIRE(other.dump() == u8"a: 1 \nb: 2\nc: 4 33\n");
+	}
+}
+
+
+TEST_CASE("reparse random edits")
+{
+	std::string base{};
+	for (int n{0}; n < 60; ++n)
+		base.append(u8"k").append(std::to_string((n * 37) % 60)).append(u8": ")
+			.append(std::to_string(n)).append(n % 3 ? u8" 7\n" : u8"\n");
+
+	// A fixed sequence of pseudo-random edits
+	std::uint32_t seed{12345};
+	auto random{[&seed](std::uint32_t limit)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		return static_cast<std::size_t>((seed >> 8) % limit);
+	}};
+
+	const std::string alphabet{u8"  \n:k1234-\"!"};
+
+	for (int round{0}; round < 2000; ++round)
+	{
+		std::string oldData{base};
+		std::string newData{oldData};
+		const std::size_t pos{random(static_cast<std::uint32_t>(newData.size() + 1))};
+		newData.erase(pos, random(6));
+		for (std::size_t n{random(6)}; n > 0; --n)
+			newData.insert(newData.begin() + static_cast<std::ptrdiff_t>(pos),
+				alphabet[random(static_cast<std::uint32_t>(alphabet.size()))]);
+
+		kcv::DocumentView<128, 256> view{oldData};
+		kcv::DocumentView<128, 256> freshView{newData};
+		REQUIRE(view.reparse(newData) == static_cast<bool>(freshView));
+		REQUIRE(describe(view) == describe(freshView));
+
+		kcv::Document doc{oldData};
+		kcv::Document freshDoc{newData};
+		REQUIRE(doc.reparse(oldData, newData) == static_cast<bool>(freshDoc));
+		REQUIRE(doc.dump() == freshDoc.dump());
+
+		// Continue from valid edits, to accumulate changes
+		if (freshDoc)
+			base = newData;
+	}
+}
+
+
+TEST_CASE("reparse random edits of a large Document")
+{
+	// Spans several checkpoints, so that the edits start
+	// the search for their item at different ones
+	std::string base{};
+	for (int n{0}; n < 2000; ++n)
+		base.append(u8"k").append(std::to_string((n * 797) % 2000)).append(u8": ")
+			.append(std::to_string(n)).append(n % 5 ? u8" \"text\"\n" : u8"\n");
+
+	std::uint32_t seed{54321};
+	auto random{[&seed](std::uint32_t limit)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		return static_cast<std::size_t>((seed >> 8) % limit);
+	}};
+
+	const std::string alphabet{u8"  \n:k1234-\""};
+	std::string oldData{base};
+	kcv::Document doc{oldData};
+	REQUIRE(doc);
+
+	for (int round{0}; round < 300; ++round)
+	{
+		std::string newData{oldData};
+		const std::size_t pos{random(static_cast<std::uint32_t>(newData.size() + 1))};
+		newData.erase(pos, random(6));
+		for (std::size_t n{random(40)}; n > 0; --n)
+			newData.insert(newData.begin() + static_cast<std::ptrdiff_t>(pos),
+				alphabet[random(static_cast<std::uint32_t>(alphabet.size()))]);
+
+		// The same document is reparsed repeatedly,
+		// so its checkpoints are shifted by every edit
+		kcv::Document freshDoc{newData};
+		REQUIRE(doc.reparse(oldData, newData) == static_cast<bool>(freshDoc));
+		REQUIRE(doc.dump() == freshDoc.dump());
+
+		if (!freshDoc)
+			doc = kcv::Document{oldData};
+		else
+			oldData = newData;
+	}
+}
+
+
+TEST_CASE("reparse with limits")
+{
+	kcv::ParseLimits limits{};
+	limits.maxItemCount = 2;
+	limits.maxValueCount = 2;
+
+	const std::string oldData{u8"a: 1 b: 2"};
+
+	SUBCASE("Document")
+	{
+		kcv::Document doc{oldData, limits};
+		REQUIRE(doc);
+		REQUIRE_FALSE(doc.reparse(oldData, u8"a: 1 b: 2 3 4"));
+		REQUIRE_FALSE(doc.reparse(u8"a: 1 b: 2 3 4", u8"a: 1 b: 2 c: 3"));
+		REQUIRE(doc.reparse(u8"a: 1 b: 2 c: 3", u8"a: 1 b: 2 3"));
+		REQUIRE_FALSE(doc.reparse(u8"a: 1 b: 2 3", u8"a: 1 b: 2 c: 3"));
+	}
+	SUBCASE("DocumentView")
+	{
+		kcv::DocumentView<8, 8> view{oldData, limits};
+		REQUIRE(view);
+		REQUIRE(view.reparse(u8"a: 1 b: 2 3"));
+		REQUIRE_FALSE(view.reparse(u8"a: 1 b: 2 3 4"));
+		REQUIRE(view.reparse(u8"a: 1 b: 2 3"));
+		REQUIRE_FALSE(view.reparse(u8"a: 1 b: 2 c: 3"));
+	}
+}
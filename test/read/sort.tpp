@@ -0,0 +1,50 @@
+TEST_CASE_TEMPLATE("read items from large DocumentView", D, kcv::DocumentView<2000>, kcv::DocumentView<2000, 2000>)
+{
+	// Keys with shared prefixes, different lengths, and
+	// bytes on both sides of the dot, in a scrambled order
+	std::vector<std::string> keys{};
+	for (int i{0}; i < 1500; ++i)
+	{
+		const int n{(i * 7919) % 1500};
+		std::string key{u8"k"};
+		key.append(std::to_string(n % 7));
+		key.append(n % 3 == 0 ? u8"." : u8"-");
+		key.append(std::to_string(n));
+		if (n % 5 == 0)
+			key.append(u8".x");
+		keys.push_back(key);
+	}
+
+	std::string data{};
+	for (std::size_t i{0}; i < keys.size(); ++i)
+		data.append(keys[i]).append(u8": ").append(std::to_string(i)).push_back('\n');
+
+	SUBCASE("sorted")
+	{
+		D doc{data};
+		REQUIRE(doc);
+		REQUIRE(doc.end() - doc.begin() == 1500);
+		REQUIRE(std::is_sorted(doc.begin(), doc.end(),
+			[](const auto& a, const auto& b) { return a.first < b.first; }));
+
+		for (std::size_t i{0}; i < keys.size(); ++i)
+		{
+			std::size_t value{0};
+			doc[keys[i]] >> value;
+			REQUIRE(value == i);
+		}
+	}
+	SUBCASE("duplicate key")
+	{
+		data.append(keys[700]).append(u8": 0\n");
+		D doc{data};
+		REQUIRE_FALSE(doc);
+	}
+	SUBCASE("duplicate long key")
+	{
+		const std::string key(255, 'a');
+		data.append(key).append(u8": 0\n").append(key).append(u8": 1\n");
+		D doc{data};
+		REQUIRE_FALSE(doc);
+	}
+}
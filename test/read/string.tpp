@@ -352,3 +352,142 @@ TEST_CASE_TEMPLATE("read string_view", D, kcv::Document, kcv::DocumentView<8>)
 		REQUIRE(v == std::string_view{});
 	}
 }
+
+
+TEST_CASE_TEMPLATE("read string into existing capacity", D, kcv::Document, kcv::DocumentView<8>)
+{
+	std::string s{};
+	s.reserve(64);
+	const char* const storage{s.data()};
+
+	SUBCASE("literal string")
+	{
+		std::string data{u8"s:\"Hello\""};
+		D doc{data};
+		doc[u8"s"] >> s;
+		REQUIRE(s == u8"Hello");
+	}
+	SUBCASE("escaped string")
+	{
+		std::string data{u8"s:\"\\\"Hello\\u00E4\\\\ \\U0001F600\\t\\\"\""};
+		D doc{data};
+		doc[u8"s"] >> s;
+		REQUIRE(s == u8"\"Hello\u00E4\\ \U0001F600\t\"");
+	}
+	SUBCASE("shorter escaped string")
+	{
+		s = u8"This is a much longer string";
+		std::string data{u8"s:\"\\\"\""};
+		D doc{data};
+		doc[u8"s"] >> s;
+		REQUIRE(s == u8"\"");
+	}
+
+	REQUIRE(s.data() == storage);
+}
+
+
+TEST_CASE_TEMPLATE("read string into StringBuffer", D, kcv::Document, kcv::DocumentView<8>)
+{
+	std::array<char, 8> chars{};
+	kcv::StringBuffer buffer{chars.data(), chars.size()};
+
+	SUBCASE("literal string")
+	{
+		std::string data{u8"s:\"Hello\""};
+		D doc{data};
+		auto item{doc[u8"s"]};
+		item >> buffer;
+		REQUIRE(item);
+		REQUIRE(std::string_view{buffer.data, buffer.size} == u8"Hello");
+	}
+	SUBCASE("escaped string")
+	{
+		std::string data{u8"s:\"a\\\\b\\u00E4\\n\""};
+		D doc{data};
+		auto item{doc[u8"s"]};
+		item >> buffer;
+		REQUIRE(item);
+		REQUIRE(std::string_view{buffer.data, buffer.size} == u8"a\\b\u00E4\n");
+	}
+	SUBCASE("empty string")
+	{
+		std::string data{u8"s:\"\""};
+		D doc{data};
+		auto item{doc[u8"s"]};
+		item >> buffer;
+		REQUIRE(item);
+		REQUIRE(buffer.size == 0);
+	}
+	SUBCASE("exact capacity")
+	{
+		std::string data{u8"s:\"12345678\""};
+		D doc{data};
+		auto item{doc[u8"s"]};
+		item >> buffer;
+		REQUIRE(item);
+		REQUIRE(std::string_view{buffer.data, buffer.size} == u8"12345678");
+	}
+	SUBCASE("literal string exceeds capacity")
+	{
+		std::string data{u8"s:\"123456789\""};
+		D doc{data};
+		auto item{doc[u8"s"]};
+		item >> buffer;
+		REQUIRE_FALSE(item);
+		REQUIRE(buffer.size == 9);
+		REQUIRE(chars[0] == 0);
+	}
+	SUBCASE("escaped string exceeds capacity")
+	{
+		std::string data{u8"s:\"\\U0001F600\\U0001F600\\t\""};
+		D doc{data};
+		auto item{doc[u8"s"]};
+		item >> buffer;
+		REQUIRE_FALSE(item);
+		REQUIRE(buffer.size == 9);
+		REQUIRE(chars[0] == 0);
+	}
+	SUBCASE("query size with null buffer")
+	{
+		kcv::StringBuffer query{nullptr, 0};
+		std::string data{u8"s:\"Hello\""};
+		D doc{data};
+		auto item{doc[u8"s"]};
+		item >> query;
+		REQUIRE_FALSE(item);
+		REQUIRE(query.size == 5);
+	}
+	SUBCASE("empty string into null buffer")
+	{
+		kcv::StringBuffer empty{nullptr, 0};
+		std::string data{u8"s:\"\" t:\"\\u0000\""};
+		D doc{data};
+		auto s{doc[u8"s"]};
+		s >> empty;
+		REQUIRE(s);
+		REQUIRE(empty.size == 0);
+		auto t{doc[u8"t"]};
+		t >> empty;
+		REQUIRE_FALSE(t);
+		REQUIRE(empty.size == 1);
+	}
+	SUBCASE("invalid escape")
+	{
+		std::string data{u8"s:\"\\uD800\""};
+		D doc{data};
+		auto item{doc[u8"s"]};
+		item >> buffer;
+		REQUIRE_FALSE(item);
+		REQUIRE(buffer.size == 0);
+	}
+	SUBCASE("number instead of string")
+	{
+		std::string data{u8"s:1"};
+		D doc{data};
+		auto item{doc[u8"s"]};
+		item >> buffer;
+		REQUIRE_FALSE(item);
+		REQUIRE(buffer.size == 0);
+	}
+}
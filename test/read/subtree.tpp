@@ -0,0 +1,122 @@
+TEST_CASE_TEMPLATE("read item from subtree", D, kcv::Document, kcv::DocumentView<8>, kcv::DocumentView<8, 8>)
+{
+	std::string data{u8"net: 0 net-a: 1 net.tcp.port: 80 net.tcp.keepalive: yes net.udp: 53 net0: 2 neta.x: 3"};
+	D doc{data};
+	REQUIRE(doc);
+
+	int i{0};
+	bool b{false};
+
+	SUBCASE("relative keys")
+	{
+		auto net{doc.subtree(u8"net")};
+		REQUIRE(net);
+		net[u8"udp"] >> i;
+		REQUIRE(i == 53);
+		net[u8"tcp.port"] >> i;
+		REQUIRE(i == 80);
+		REQUIRE_FALSE(net[u8"net"] >> i);
+		REQUIRE_FALSE(net[u8"a"] >> i);
+		REQUIRE_FALSE(net[u8"x"] >> i);
+	}
+	SUBCASE("nested subtree")
+	{
+		auto tcp{doc.subtree(u8"net").subtree(u8"tcp")};
+		REQUIRE(tcp);
+		tcp[u8"port"] >> i;
+		REQUIRE(i == 80);
+		tcp[u8"keepalive"] >> b;
+		REQUIRE(b == true);
+	}
+	SUBCASE("dotted prefix")
+	{
+		auto tcp{doc.subtree(u8"net.tcp")};
+		REQUIRE(tcp);
+		tcp[u8"port"] >> i;
+		REQUIRE(i == 80);
+	}
+	SUBCASE("invalid prefix")
+	{
+		REQUIRE_FALSE(doc.subtree(u8""));
+		REQUIRE_FALSE(doc.subtree(u8"net").subtree(u8""));
+	}
+}
+
+
+TEST_CASE_TEMPLATE("count subtree items", D, kcv::Document, kcv::DocumentView<8>, kcv::DocumentView<8, 8>)
+{
+	std::string data{u8"net: 0 net-a: 1 net.tcp.port: 80 net.tcp.keepalive: yes net.udp: 53 net0: 2 neta.x: 3"};
+	const D doc{data};
+
+	REQUIRE(doc.subtree(u8"net").size() == 3);
+	REQUIRE(doc.subtree(u8"net").subtree(u8"tcp").size() == 2);
+	REQUIRE(doc.subtree(u8"net.tcp").size() == 2);
+	REQUIRE(doc.subtree(u8"net.udp").size() == 0);
+	REQUIRE(doc.subtree(u8"neta").size() == 1);
+	REQUIRE(doc.subtree(u8"x").size() == 0);
+	REQUIRE(doc.subtree(u8"x"));
+
+	D failed{u8"a.b: 1 a.b: 2"};
+	REQUIRE(failed.subtree(u8"a").size() == 0);
+}
+
+
+TEST_CASE_TEMPLATE("subtree of failed DocumentView", D, kcv::DocumentView<8>, kcv::DocumentView<8, 8>)
+{
+	D failed{u8"a.b: 1 a.b: 2"};
+	REQUIRE_FALSE(failed.subtree(u8"a"));
+}
+
+
+TEST_CASE("read Document subtree without inserting")
+{
+	kcv::Document doc{u8"net.tcp.port: 80\nnet.udp: 53\n"};
+	int i{0};
+
+	auto net{doc.subtree(u8"net")};
+	REQUIRE(net.find(u8"udp") >> i);
+	REQUIRE(i == 53);
+	REQUIRE(net.subtree(u8"tcp").find(u8"port") >> i);
+	REQUIRE(i == 80);
+	REQUIRE_FALSE(net.find(u8"missing"));
+	REQUIRE_FALSE(net.find(u8""));
+
+	const kcv::Document& constDoc{doc};
+	REQUIRE_FALSE(constDoc.subtree(u8"net")[u8"missing"] >> i);
+	REQUIRE_FALSE(constDoc.subtree(u8"0net"));
+	REQUIRE(doc.dump() == u8"net.tcp.port: 80\nnet.udp: 53\n");
+}
+
+
+TEST_CASE("write item to Document subtree")
+{
+	kcv::Document doc{};
+	auto tcp{doc.subtree(u8"net").subtree(u8"tcp")};
+	REQUIRE(tcp);
+	tcp[u8"port"] << 80;
+	tcp[u8"keepalive"] << true;
+	doc.subtree(u8"net")[u8"udp"] << 53;
+	REQUIRE(doc.dump() == u8"net.tcp.keepalive: yes\nnet.tcp.port: 80\nnet.udp: 53\n");
+
+	REQUIRE_FALSE(tcp[u8""]);
+	REQUIRE_FALSE(doc.subtree(u8"0net"));
+	REQUIRE_FALSE(doc.subtree(u8"net!"));
+}
+
+
+TEST_CASE("insert items into empty Document subtree")
+{
+	kcv::Document doc{u8"a: 1 z: 2"};
+	auto net{doc.subtree(u8"net")};
+	REQUIRE(net.size() == 0);
+
+	net[u8"udp"] << 53;
+	net[u8"tcp"] << 80;
+	net[u8"x"] << 0;
+	REQUIRE(net.size() == 3);
+
+	std::string keys{};
+	for (auto [key, item] : net)
+		keys.append(key).push_back(' ');
+	REQUIRE(keys == u8"tcp udp x ");
+}
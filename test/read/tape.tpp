@@ -0,0 +1,135 @@
+TEST_CASE_TEMPLATE("read item from value tape", D, kcv::DocumentView<8>, kcv::DocumentView<8, 8>)
+{
+	bool b{false};
+	int i{1};
+	double f{1.0};
+	std::string s{};
+	std::string_view v{};
+
+	SUBCASE("all value types")
+	{
+		std::string data{u8"a: yes 42 0x2A 4.2 \"A\" \"\\t\"  b: -1"};
+		D doc{data};
+		REQUIRE(doc);
+		int h{1};
+		std::string e{};
+		auto item{doc[u8"a"]};
+		item >> b >> i >> h >> f >> v >> e;
+		REQUIRE(item);
+		REQUIRE(b == true);
+		REQUIRE(i == 42);
+		REQUIRE(h == 42);
+		REQUIRE(f == 4.2);
+		REQUIRE(v == u8"A");
+		REQUIRE(e == u8"\t");
+		item >> i;
+		REQUIRE_FALSE(item);
+		doc[u8"b"] >> i;
+		REQUIRE(i == -1);
+	}
+	SUBCASE("values stay within their item")
+	{
+		std::string data{u8"b:2 22 a:1 c: 3"};
+		D doc{data};
+		auto a{doc[u8"a"]};
+		a >> i;
+		REQUIRE(i == 1);
+		a >> i;
+		REQUIRE_FALSE(a);
+		auto c{doc[u8"c"]};
+		c >> i;
+		REQUIRE(i == 3);
+		c >> i;
+		REQUIRE_FALSE(c);
+	}
+	SUBCASE("failed conversion advances the position")
+	{
+		std::string data{u8"a:yes 2"};
+		D doc{data};
+		auto item{doc[u8"a"]};
+		item >> i;
+		REQUIRE_FALSE(item);
+		REQUIRE(i == 1);
+	}
+	SUBCASE("size")
+	{
+		std::string data{u8"a: b:1 c:1 \"2\" yes d:1"};
+		D doc{data};
+		REQUIRE(doc[u8"a"].size() == 0);
+		REQUIRE(doc[u8"b"].size() == 1);
+		REQUIRE(doc[u8"c"].size() == 3);
+		REQUIRE(doc[u8"x"].size() == 0);
+	}
+	SUBCASE("size is independent of read position")
+	{
+		std::string data{u8"a:1 2 3"};
+		D doc{data};
+		auto item{doc[u8"a"]};
+		item >> i;
+		REQUIRE(item.size() == 3);
+	}
+	SUBCASE("at")
+	{
+		std::string data{u8"a:11 \"22\" 33"};
+		D doc{data};
+		auto item{doc[u8"a"]};
+		item.at(2) >> i;
+		REQUIRE(i == 33);
+		item.at(1) >> s;
+		REQUIRE(s == u8"22");
+		item.at(0) >> i;
+		REQUIRE(i == 11);
+		auto copy{item.at(1)};
+		copy >> s >> i;
+		REQUIRE(copy);
+		REQUIRE(i == 33);
+	}
+	SUBCASE("at is independent of read position")
+	{
+		std::string data{u8"a:11 22"};
+		D doc{data};
+		auto item{doc[u8"a"]};
+		item >> i >> i >> i;
+		REQUIRE_FALSE(item);
+		auto first{item.at(0)};
+		first >> i;
+		REQUIRE(first);
+		REQUIRE(i == 11);
+	}
+	SUBCASE("at out of range")
+	{
+		std::string data{u8"a:11 22 b:33"};
+		D doc{data};
+		REQUIRE_FALSE(doc[u8"a"].at(2));
+		REQUIRE_FALSE(doc[u8"x"].at(0));
+	}
+}
+
+
+TEST_CASE("read item from limited value tape")
+{
+	int i{1};
+
+	SUBCASE("MaxValueCount=2")
+	{
+		std::string data{u8"a:11 b:22"};
+		kcv::DocumentView<2, 2> doc{data};
+		REQUIRE(doc);
+		doc[u8"b"] >> i;
+		REQUIRE(i == 22);
+	}
+	SUBCASE("MaxValueCount=2 overflow")
+	{
+		std::string data{u8"a:11 b:22 33"};
+		kcv::DocumentView<2, 2> doc{data};
+		REQUIRE_FALSE(doc);
+	}
+	SUBCASE("items without values")
+	{
+		std::string data{u8"a: b: c:"};
+		kcv::DocumentView<4, 1> doc{data};
+		REQUIRE(doc);
+		REQUIRE(doc[u8"b"]);
+		REQUIRE(doc[u8"b"].size() == 0);
+	}
+}
@@ -0,0 +1,89 @@
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include "doctest/doctest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "kcv/kcv.hpp"
+
+
+std::uint64_t tokenCount(const kcv::Stats& stats, kcv::TokenType type)
+{
+	return stats.tokens[static_cast<std::size_t>(type)];
+}
+
+
+TEST_CASE("stats of Document")
+{
+	kcv::resetStats();
+
+	SUBCASE("reset")
+	{
+		kcv::Document doc{u8"a:1"};
+		kcv::resetStats();
+		const kcv::Stats stats{kcv::stats()};
+		REQUIRE(stats.bytes == 0);
+		REQUIRE(tokenCount(stats, kcv::TokenType::key) == 0);
+		REQUIRE(stats.allocations == 0);
+	}
+	SUBCASE("tokens and bytes")
+	{
+		std::string data{u8" a: yes 1 b:\"x\"\n"};
+		kcv::Document doc{data};
+		const kcv::Stats stats{kcv::stats()};
+		REQUIRE(stats.bytes == data.size());
+		REQUIRE(tokenCount(stats, kcv::TokenType::key) == 2);
+		REQUIRE(tokenCount(stats, kcv::TokenType::boolYes) == 1);
+		REQUIRE(tokenCount(stats, kcv::TokenType::numIntPos) == 1);
+		REQUIRE(tokenCount(stats, kcv::TokenType::strLiteral) == 1);
+		REQUIRE(tokenCount(stats, kcv::TokenType::eof) == 1);
+		REQUIRE(tokenCount(stats, kcv::TokenType::bad) == 0);
+	}
+	SUBCASE("allocations")
+	{
+		kcv::Document doc{u8"a:1 b:2"};
+		REQUIRE(kcv::stats().allocations == 2);
+		doc[u8"this-key-exceeds-the-small-buffer"];
+		REQUIRE(kcv::stats().allocations == 4);
+	}
+	SUBCASE("lookups and misses")
+	{
+		kcv::Document doc{u8"a:1"};
+		doc[u8"a"];
+		doc[u8"b"];
+		doc[u8"b"];
+		const kcv::Stats stats{kcv::stats()};
+		REQUIRE(stats.lookups == 3);
+		REQUIRE(stats.misses == 1);
+	}
+	SUBCASE("conversions")
+	{
+		kcv::Document doc{u8"a:1 2 3"};
+		int i{};
+		doc[u8"a"] >> i >> i;
+		REQUIRE(kcv::stats().conversions == 2);
+	}
+}
+
+
+TEST_CASE("stats of DocumentView")
+{
+	kcv::resetStats();
+
+	SUBCASE("tokens, lookups and misses")
+	{
+		std::string data{u8"b:0x1 a:-1 2.5"};
+		kcv::DocumentView<8> doc{data};
+		doc[u8"a"];
+		doc[u8"c"];
+		const kcv::Stats stats{kcv::stats()};
+		REQUIRE(stats.bytes == data.size());
+		REQUIRE(tokenCount(stats, kcv::TokenType::numHex) == 1);
+		REQUIRE(tokenCount(stats, kcv::TokenType::numIntNeg) == 1);
+		REQUIRE(tokenCount(stats, kcv::TokenType::numFloat) == 1);
+		REQUIRE(stats.lookups == 2);
+		REQUIRE(stats.misses == 1);
+		REQUIRE(stats.allocations == 0);
+	}
+}
@@ -1,11 +1,14 @@
 #define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
 #include "doctest/doctest.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <limits>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "kcv/kcv.hpp"
 
@@ -15,19 +18,37 @@ TYPE_TO_STRING(kcv::DocumentView<0>);
 TYPE_TO_STRING(kcv::DocumentView<1>);
 TYPE_TO_STRING(kcv::DocumentView<2>);
 TYPE_TO_STRING(kcv::DocumentView<8>);
+TYPE_TO_STRING(kcv::DocumentView<8, 8>);
 
 
+#include "read/bind.tpp"
 #include "read/bool.tpp"
+#include "read/cache.tpp"
+#include "read/constexpr.tpp"
+#include "read/diff.tpp"
+#include "read/dump.tpp"
 #include "read/float.tpp"
 #include "read/hex.tpp"
 #include "read/int.tpp"
 #include "read/item.tpp"
+#include "read/keytable.tpp"
+#include "read/limits.tpp"
+#include "read/iterate.tpp"
+#include "read/overlay.tpp"
+#include "read/range.tpp"
+#include "read/reparse.tpp"
+#include "read/sort.tpp"
 #include "read/string.tpp"
+#include "read/subtree.tpp"
+#include "read/tape.tpp"
 #include "read/utf8.tpp"
 
 #include "write/bool.tpp"
+#include "write/builder.tpp"
 #include "write/float.tpp"
 #include "write/hex.tpp"
 #include "write/int.tpp"
 #include "write/item.tpp"
+#include "write/set.tpp"
 #include "write/string.tpp"
+#include "write/writer.tpp"
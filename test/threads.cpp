@@ -0,0 +1,114 @@
+#define DOCTEST_CONFIG_SUPER_FAST_ASSERTS
+#include "doctest/doctest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "kcv/kcv.hpp"
+
+
+// Checks that const lookups on a shared document return correct
+// results while several threads read at once, and that they do
+// not race, which is best verified with -fsanitize=thread. The
+// printed speedup is informational only. It depends on the cores
+// and the load of the machine, so it is not asserted.
+
+
+namespace {
+
+constexpr std::size_t itemCount{1000};
+constexpr std::size_t roundCount{200};
+
+std::string makeData()
+{
+	std::string data{};
+	for (std::size_t n{0}; n < itemCount; ++n)
+		data += "key" + std::to_string(n) + ": " + std::to_string(n) + " \"v\"\n";
+	return data;
+}
+
+std::vector<std::string> makeKeys()
+{
+	std::vector<std::string> keys{};
+	for (std::size_t n{0}; n < itemCount; ++n)
+		keys.push_back("key" + std::to_string(n));
+	return keys;
+}
+
+std::size_t threadCount()
+{
+	return std::clamp<std::size_t>(std::thread::hardware_concurrency(), 2, 8);
+}
+
+// Looks up and reads every key roundCount times.
+// Returns the number of wrong results.
+template<typename D>
+std::size_t readAll(const D& doc, const std::vector<std::string>& keys)
+{
+	std::size_t errors{0};
+
+	for (std::size_t round{0}; round < roundCount; ++round)
+	{
+		for (std::size_t n{0}; n < keys.size(); ++n)
+		{
+			std::size_t i{0};
+			std::string_view s{};
+			if (!doc.find(keys[n]).read(i, s) || i != n || s != "v")
+				++errors;
+		}
+
+		if (doc.find("absent"))
+			++errors;
+	}
+
+	return errors;
+}
+
+// Runs readAll on several threads at once.
+// Returns the number of wrong results.
+template<typename D>
+std::size_t readConcurrently(const D& doc, const std::vector<std::string>& keys, std::size_t count)
+{
+	std::atomic<std::size_t> errors{0};
+	std::vector<std::thread> threads{};
+
+	for (std::size_t t{0}; t < count; ++t)
+		threads.emplace_back([&]() { errors += readAll(doc, keys); });
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	return errors;
+}
+
+}  // namespace
+
+
+TEST_CASE_TEMPLATE("concurrent const lookups", D, kcv::Document, kcv::DocumentView<itemCount>, kcv::DocumentView<itemCount, itemCount*2>)
+{
+	const std::string data{makeData()};
+	const std::vector<std::string> keys{makeKeys()};
+	const D doc{data};
+	REQUIRE(doc);
+
+	using Clock = std::chrono::steady_clock;
+	const std::size_t count{threadCount()};
+
+	const auto start{Clock::now()};
+	REQUIRE(readConcurrently(doc, keys, 1) == 0);
+	const auto middle{Clock::now()};
+	REQUIRE(readConcurrently(doc, keys, count) == 0);
+	const auto end{Clock::now()};
+
+	// Every thread does the same work, so with linear scaling,
+	// both runs would take the same time. Not asserted, see above.
+	const double single{std::chrono::duration<double>(middle - start).count()};
+	const double multi{std::chrono::duration<double>(end - middle).count()};
+	MESSAGE(count, " threads on ", std::thread::hardware_concurrency(), " cores: ",
+		(single * static_cast<double>(count)) / multi, "x speedup");
+}
@@ -0,0 +1,102 @@
+TEST_CASE("write items with DocumentBuilder")
+{
+	SUBCASE("no item")
+	{
+		kcv::DocumentBuilder builder{};
+		kcv::Document doc{builder.build()};
+		REQUIRE(doc);
+		REQUIRE(doc.dump() == u8"");
+	}
+	SUBCASE("sorted keys")
+	{
+		kcv::DocumentBuilder builder{3};
+		builder.append(u8"a") << 1;
+		builder.append(u8"b") << 2 << 22;
+		builder.append(u8"c");
+		REQUIRE(builder);
+		kcv::Document doc{builder.build()};
+		REQUIRE(doc);
+		REQUIRE(doc.dump() == u8"a: 1\nb: 2 22\nc:\n");
+	}
+	SUBCASE("unsorted keys are sorted")
+	{
+		kcv::DocumentBuilder builder{};
+		builder.append(u8"c") << 3;
+		builder.append(u8"a") << 1;
+		builder.append(u8"b") << 2;
+		kcv::Document doc{builder.build()};
+		REQUIRE(doc);
+		REQUIRE(doc.dump() == u8"a: 1\nb: 2\nc: 3\n");
+	}
+	SUBCASE("built document is writable")
+	{
+		kcv::DocumentBuilder builder{};
+		builder.append(u8"b") << 2;
+		kcv::Document doc{builder.build()};
+		doc[u8"a"] << 1;
+		doc[u8"b"] << 22;
+		REQUIRE(doc.dump() == u8"a: 1\nb: 22\n");
+	}
+	SUBCASE("builder is reset after build")
+	{
+		kcv::DocumentBuilder builder{};
+		builder.append(u8"a") << 1;
+		kcv::Document first{builder.build()};
+		builder.append(u8"a") << 2;
+		kcv::Document second{builder.build()};
+		REQUIRE(first.dump() == u8"a: 1\n");
+		REQUIRE(second.dump() == u8"a: 2\n");
+	}
+	SUBCASE("invalid key")
+	{
+		kcv::DocumentBuilder builder{};
+		auto item{builder.append(u8"1a")};
+		REQUIRE_FALSE(item);
+		REQUIRE_FALSE(builder);
+		REQUIRE_FALSE(builder.build());
+	}
+	SUBCASE("failed builder ignores further items")
+	{
+		kcv::DocumentBuilder builder{};
+		builder.append(u8"a/b");
+		auto item{builder.append(u8"c")};
+		REQUIRE_FALSE(item);
+		REQUIRE_FALSE(builder.build());
+	}
+	SUBCASE("duplicate sorted key")
+	{
+		kcv::DocumentBuilder builder{};
+		builder.append(u8"a") << 1;
+		auto item{builder.append(u8"a")};
+		REQUIRE_FALSE(item);
+		REQUIRE_FALSE(builder.build());
+	}
+	SUBCASE("duplicate unsorted key")
+	{
+		kcv::DocumentBuilder builder{};
+		builder.append(u8"b") << 1;
+		builder.append(u8"a") << 2;
+		auto item{builder.append(u8"b")};
+		REQUIRE(item);
+		kcv::Document doc{builder.build()};
+		REQUIRE_FALSE(doc);
+		REQUIRE(doc.dump() == u8"");
+	}
+	SUBCASE("requireSorted accepts ascending keys")
+	{
+		kcv::DocumentBuilder builder{2, true};
+		builder.append(u8"a") << 1;
+		builder.append(u8"b") << 2;
+		REQUIRE(builder);
+		REQUIRE(builder.build().dump() == u8"a: 1\nb: 2\n");
+	}
+	SUBCASE("requireSorted rejects descending keys")
+	{
+		kcv::DocumentBuilder builder{2, true};
+		builder.append(u8"b") << 2;
+		auto item{builder.append(u8"a")};
+		REQUIRE_FALSE(item);
+		REQUIRE_FALSE(builder);
+		REQUIRE_FALSE(builder.build());
+	}
+}
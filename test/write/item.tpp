@@ -306,3 +306,48 @@ TEST_CASE("write item whitespace consistency")
 		REQUIRE(doc.dump() == u8"a: 42\n");
 	}
 }
+
+
+TEST_CASE("write item values at once")
+{
+	kcv::Document doc{};
+
+	SUBCASE("mixed value types")
+	{
+		auto a{doc[u8"a"]};
+		a.write(42, 3.14159, true, u8"Hello", std::string{u8"\""}, kcv::hex(10, 2), kcv::nl(), kcv::fixed(1.5, 1));
+		REQUIRE(a);
+		REQUIRE(doc.dump() == u8"a: 42 3.14159 yes \"Hello\" \"\\\"\" 0x0a\n1.5\n");
+	}
+	SUBCASE("equivalent to consecutive writes")
+	{
+		auto a{doc[u8"a"]};
+		a << 1 << 2;
+		a.write(3, 4);
+		doc[u8"b"].write(1, 2) << 3;
+		REQUIRE(doc.dump() == u8"a: 1 2 3 4\nb: 1 2 3\n");
+	}
+	SUBCASE("replaces values after read")
+	{
+		kcv::Document abc{u8"a:1 2"};
+		auto a{abc[u8"a"]};
+		int i{};
+		a >> i;
+		a.write(3, 4);
+		REQUIRE(abc.dump() == u8"a: 3 4\n");
+	}
+	SUBCASE("invalid values are ignored")
+	{
+		auto a{doc[u8"a"]};
+		a.write(1, std::numeric_limits<float>::quiet_NaN(), 2);
+		REQUIRE_FALSE(a);
+		REQUIRE(doc.dump() == u8"a: 1 2\n");
+	}
+	SUBCASE("writing to invalid item has no effect")
+	{
+		auto foo{doc[u8"???"]};
+		foo.write(42, 1.0, u8"Hello");
+		REQUIRE_FALSE(foo);
+		REQUIRE(doc.dump() == u8"");
+	}
+}
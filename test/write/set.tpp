@@ -0,0 +1,58 @@
+TEST_CASE("set values in place")
+{
+	kcv::Document doc{u8"a: 1234\nb:\nc:  \"x\" 2  \nd: 5"};
+	REQUIRE(doc);
+	int i{0};
+
+	SUBCASE("fits")
+	{
+		REQUIRE(doc[u8"a"].set(7));
+		REQUIRE(doc.dump() == u8"a: 7   \nb:\nc:  \"x\" 2  \nd: 5\n");
+		REQUIRE(doc[u8"a"] >> i);
+		REQUIRE(i == 7);
+
+		REQUIRE(doc[u8"c"].set(u8"yz"));
+		REQUIRE(doc.dump() == u8"a: 7   \nb:\nc:  \"yz\"   \nd: 5\n");
+	}
+	SUBCASE("grows")
+	{
+		REQUIRE(doc[u8"a"].set(123456));
+		REQUIRE(doc[u8"b"].set(true));
+		REQUIRE(doc[u8"d"].set(-56));
+		REQUIRE(doc.dump() == u8"a: 123456\nb: yes\nc:  \"x\" 2  \nd: -56\n");
+		REQUIRE_FALSE(doc[u8"b"] >> i);
+	}
+	SUBCASE("fixed width")
+	{
+		REQUIRE(doc[u8"a"].set(kcv::hex(1, 8)));
+		const std::string dump{doc.dump()};
+		for (unsigned int n : {0xFFu, 0x12345678u, 0u})
+		{
+			REQUIRE(doc[u8"a"].set(kcv::hex(n, 8)));
+			REQUIRE(doc.dump().size() == dump.size());
+			unsigned int u{1};
+			REQUIRE(doc[u8"a"] >> u);
+			REQUIRE(u == n);
+		}
+	}
+	SUBCASE("invalid value")
+	{
+		REQUIRE_FALSE(doc[u8"a"].set(std::numeric_limits<double>::quiet_NaN()));
+		REQUIRE(doc[u8"a"] >> i);
+		REQUIRE(i == 1234);
+	}
+	SUBCASE("resets positions")
+	{
+		auto item{doc[u8"c"]};
+		REQUIRE(item.set(3) << 4);
+		REQUIRE(doc.dump() == u8"a: 1234\nb:\nc: 4\nd: 5\n");
+	}
+	SUBCASE("cached values")
+	{
+		doc.cacheValues(true);
+		REQUIRE(doc[u8"a"] >> i);
+		REQUIRE(doc[u8"a"].set(9));
+		REQUIRE(doc[u8"a"] >> i);
+		REQUIRE(i == 9);
+	}
+}
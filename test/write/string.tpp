@@ -61,6 +61,25 @@ TEST_CASE("write string escape special characters")
 		doc[u8"s"] << u8"\\";
 		REQUIRE(doc.dump() == u8"s: \"\\\\\"\n");
 	}
+	SUBCASE("escape within long string")
+	{
+		doc[u8"s"] << u8"0123456789\"0123456789\\0123456789\"\\\\0123456789";
+		REQUIRE(doc.dump() == u8"s: \"0123456789\\\"0123456789\\\\0123456789\\\"\\\\\\\\0123456789\"\n");
+	}
+	SUBCASE("escape at every position of a block")
+	{
+		for (std::size_t i{0}; i < 16; ++i)
+		{
+			std::string s(16, 'a');
+			s[i] = '"';
+			std::string expected{"s: \"" + s + "\"\n"};
+			expected.insert(4 + i, 1, '\\');
+
+			kcv::Document d{};
+			d[u8"s"] << s;
+			REQUIRE(d.dump() == expected);
+		}
+	}
 }
 
 
@@ -120,4 +139,11 @@ TEST_CASE("write string invalid utf8 encoding")
 		REQUIRE_FALSE(s);
 		REQUIRE(doc.dump() == u8"s:\n");
 	}
+	SUBCASE("invalid byte after long escaped prefix")
+	{
+		s << 1;
+		s << u8"0123456789\"0123456789\xF5";
+		REQUIRE_FALSE(s);
+		REQUIRE(doc.dump() == u8"s: 1\n");
+	}
 }
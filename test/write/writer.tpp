@@ -0,0 +1,56 @@
+TEST_CASE("write items with Writer")
+{
+	std::string out{};
+
+	SUBCASE("call order")
+	{
+		kcv::Writer writer{out};
+		REQUIRE(writer.write(u8"c", 3));
+		REQUIRE(writer.write(u8"a", 1, 2.5, true, u8"x y"));
+		REQUIRE(writer.write(u8"b"));
+		REQUIRE(writer);
+		REQUIRE(out == u8"c: 3\na: 1 2.5 yes \"x y\"\nb:\n");
+		REQUIRE(kcv::Document{out}.dump() == u8"a: 1 2.5 yes \"x y\"\nb:\nc: 3\n");
+	}
+	SUBCASE("formatters")
+	{
+		kcv::Writer writer{out};
+		REQUIRE(writer.write(u8"a", kcv::hex(255, 4), kcv::fixed(1.5, 2)));
+		REQUIRE(out == u8"a: 0x00ff 1.50\n");
+	}
+	SUBCASE("invalid keys and values")
+	{
+		kcv::Writer writer{out};
+		REQUIRE_FALSE(writer.write(u8"1a", 1));
+		REQUIRE(out.empty());
+		REQUIRE_FALSE(writer);
+		REQUIRE_FALSE(writer.write(u8"a", 1, std::numeric_limits<double>::infinity(), 2));
+		REQUIRE(out == u8"a: 1 2\n");
+	}
+	SUBCASE("duplicate keys")
+	{
+		kcv::Writer unchecked{out};
+		REQUIRE(unchecked.write(u8"a", 1));
+		REQUIRE(unchecked.write(u8"a", 2));
+		REQUIRE(unchecked);
+
+		out.clear();
+		kcv::Writer checked{out, true};
+		REQUIRE(checked.write(u8"a", 1));
+		REQUIRE_FALSE(checked.write(u8"a", 2));
+		REQUIRE_FALSE(checked);
+		REQUIRE(out == u8"a: 1\n");
+	}
+	SUBCASE("many checked keys")
+	{
+		kcv::Writer writer{out, true};
+		for (int i{0}; i < 1000; ++i)
+		{
+			REQUIRE(writer.write(u8"k" + std::to_string(i), i));
+			out.clear();
+		}
+		for (int i{0}; i < 1000; ++i)
+			REQUIRE_FALSE(writer.write(u8"k" + std::to_string(i), i));
+		REQUIRE(out.empty());
+	}
+}